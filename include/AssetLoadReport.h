@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace JadeEngine
+{
+  /**
+  Kinds of assets loaded by Game::Initialize.
+  */
+  enum AssetType
+  {
+    kAssetType_Texture,
+    kAssetType_SpriteSheet,
+    kAssetType_Cursor,
+    kAssetType_Font,
+    kAssetType_Sound,
+  };
+
+  /**
+  Cost of loading a single asset, all times in milliseconds.
+  */
+  struct AssetLoadTiming
+  {
+    std::string name;
+    AssetType   type;
+
+    /**
+    Time spent reading and decoding the asset, on a worker thread for textures, sprite-sheets and cursors and on the main thread otherwise.
+    */
+    float       decodeTime;
+
+    /**
+    Time spent on the main thread creating SDL2 resources out of the decoded asset, e.g. uploading a texture.
+    */
+    float       uploadTime;
+
+    bool        success;
+  };
+
+  /**
+  Startup timing report of Game::Initialize asset loading.
+
+  @see Game::GetAssetLoadReport
+  */
+  struct AssetLoadReport
+  {
+    /**
+    Assets in the order they finished loading.
+    */
+    std::vector<AssetLoadTiming> assets;
+
+    /**
+    Number of worker threads used for decoding.
+    */
+    size_t workerCount;
+
+    /**
+    Time spent packing textures into atlas pages, see GameInitParams::packTextures.
+    */
+    float packTime;
+
+    /**
+    Wall-clock time of the whole loading.
+    */
+    float totalTime;
+  };
+}
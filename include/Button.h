@@ -120,7 +120,7 @@ namespace JadeEngine
 
     void Show(const bool shown) override;
 
-    void Update() override;
+    void OnUIEvent(UIEvent& event) override;
 
     void SetPosition(uint32_t x, uint32_t y);
     void SetCenterPosition(uint32_t x, uint32_t y);
@@ -136,9 +136,16 @@ namespace JadeEngine
 
     void SetText(const std::string& text);
 
-    bool Pressed() { return _pressed; }
-    bool Down() { return _down; }
-    bool Released() { return _released; }
+    /**
+    Returns whether the button was pressed this frame.
+    */
+    bool Pressed() const;
+    bool Down() const { return _down; }
+
+    /**
+    Returns whether the button was released this frame, after being pressed and without the mouse leaving it in-between.
+    */
+    bool Released() const;
 
   private:
     void AdjustTextPosition();
@@ -160,8 +167,8 @@ namespace JadeEngine
     bool _disabled;
 
     bool _hovered;
-    bool _pressed;
-    bool _released;
     bool _down;
+    uint64_t _pressedFrame;
+    uint64_t _releasedFrame;
   };
 }
\ No newline at end of file
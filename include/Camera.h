@@ -39,7 +39,7 @@ namespace JadeEngine
   public:
     WorldCamera();
 
-    Box_i32 WorldToScreen(const std::shared_ptr<Transform>& transform);
+    Box_i32 WorldToScreen(const Transform& transform);
     Vector2D_i32 WorldToScreen(const Vector2D_i32& vector);
     Rectangle WorldToScreen(const Rectangle& rect);
     SDL_Point WorldToScreen(const SDL_Point& point);
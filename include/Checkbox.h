@@ -26,16 +26,19 @@ namespace JadeEngine
   public:
     Checkbox(const CheckboxParams& params);
 
-    void Update() override;
+    void OnUIEvent(UIEvent& event) override;
 
     void Show(const bool shown) override;
 
-    bool Changed() const { return _checkedChanged; }
+    /**
+    Returns whether the checkbox was toggled this frame.
+    */
+    bool Changed() const;
     bool Checked() const { return _checked; }
 
   private:
     bool _checked;
-    bool _checkedChanged;
+    uint64_t _changedFrame;
 
     Sprite* _checkedSprite;
     Sprite* _emptySprite;
@@ -42,6 +42,7 @@ namespace JadeEngine
     Dropdown(const DropdownParams& params);
 
     void Update() override;
+    void OnUIEvent(UIEvent& event) override;
 
     template<typename InputIt>
     void AddEntries(InputIt first, InputIt last)
@@ -56,7 +57,10 @@ namespace JadeEngine
 
     void Show(const bool shown) override;
 
-    bool Changed() const { return _changed; }
+    /**
+    Returns whether a different entry was picked this frame.
+    */
+    bool Changed() const;
     int32_t GetIndex() const { return _currentEntry; }
 
     void SetIndex(int32_t index);
@@ -67,6 +71,8 @@ namespace JadeEngine
 
     void Expand();
     void Contract();
+    void Pick(const int32_t index);
+    void Scroll(const int32_t wheelY);
 
     BoxSprite* _box;
     Sprite* _expandArrowSprite;
@@ -94,7 +100,7 @@ namespace JadeEngine
     int32_t _scrollOffset;
 
     bool _expanded;
-    bool _changed;
+    uint64_t _changedFrame;
   };
 
 }
@@ -49,6 +49,14 @@ namespace JadeEngine
 
   const int32_t kDefaultMaxResolutionFraction = 8;
 
+  const int32_t kTextureAtlasPageSize = 1024;
+  const int32_t kTextureAtlasMaxEntrySize = 256;
+
+  const int32_t kHitMaskTileSize = 16;
+
+  const uint32_t kObjectArenaBlockSize = 64 * 1024;
+  const uint32_t kObjectPoolFirstBlockObjects = 16;
+
   const auto kFPI = std::acos(-1.0f);
 
   using SettingID = int32_t;
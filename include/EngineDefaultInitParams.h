@@ -22,6 +22,19 @@ namespace JadeEngine
     kLightGreyColor,
   };
 
+  const FTCParams kDefaultProfilerFTCParams = {
+    //ObjectLayer layer;
+    kObjectLayer_Persistent_UI,
+    //std::string fontName;
+    kKennyFontSquare,
+    //uint32_t fontSize;
+    12,
+    //std::string format;
+    "Frame: # Destroy: # Load: # Hover: # Update: # Scene: # Transforms: # Render: # Present: # (ms) Draws: #/# Texture switches: #/#",
+    //SDL_Color defaultColor;
+    kLightGreyColor,
+  };
+
   const auto kDefaultFontSizes = decltype(GameInitParams::fontSizes){ 12, 16, 24, 32, 64 };
 
   const auto kDefaultTextures = decltype(GameInitParams::textures){
@@ -1,13 +1,16 @@
 #pragma once
 
 #include "EngineDataTypes.h"
+#include "HitMask.h"
 
 #include <cstdint>
+#include <memory>
 #include <SDL_mouse.h>
 #include <SDL_surface.h>
 #include <SDL_ttf.h>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace JadeEngine::detail
 {
@@ -35,6 +38,13 @@ namespace JadeEngine::detail
     std::unordered_map<std::string, SpriteSheetEntryDescription> sprites;
   };
 
+  struct DecodedImageDescription
+  {
+    SDL_Surface* surface;
+    Rectangle boundingBox;
+    std::shared_ptr<const HitMask> hitMask;
+  };
+
   struct KeyBindingDescription
   {
     std::string uiDescription;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <chrono>
+#include <cstdint>
 #include <vector>
 
 namespace JadeEngine
@@ -26,6 +27,9 @@ namespace JadeEngine
     void Start();
     void Tick();
 
+    // Positive value makes every Tick advance by exactly that many seconds instead of the wall-clock time
+    void SetFixedDeltaTime(const float fixedDeltaTime) { _fixedDeltaTime = fixedDeltaTime; }
+
     void SetLastSaveTime();
     int64_t GetLastSaveTime();
     float TimeElapsedSinceSave(const int64_t saveTime) const;
@@ -37,6 +41,7 @@ namespace JadeEngine
     std::chrono::steady_clock::time_point _start;
     std::chrono::steady_clock::time_point _previousTick;
     std::chrono::steady_clock::time_point _now;
+    float _fixedDeltaTime;
 
     std::chrono::system_clock::time_point _lastSaveSystemTime;
     int64_t _lastSaveSystemTimeSinceEpoch;
@@ -44,5 +49,27 @@ namespace JadeEngine
     std::vector<details::TimeBoundTask> _timeBoundTasks;
   };
 
+  /**
+  Caps the frame rate by waiting at the end of each frame until the next one is due.
+
+  Sleeps through most of the remaining time and yields for the last two milliseconds, sleeping alone tends to overshoot.
+  A frame that ran late is not made up for by shortening the following ones.
+  */
+  class FramePacer
+  {
+  public:
+    FramePacer();
+
+    /**
+    @param framesPerSecond Maximum frame rate, 0 to not wait at all.
+    */
+    void SetFrameRateCap(const uint32_t framesPerSecond);
+    void Wait();
+
+  private:
+    std::chrono::steady_clock::duration _period;
+    std::chrono::steady_clock::time_point _nextFrame;
+  };
+
   extern Time GTime;
 }
\ No newline at end of file
@@ -1,20 +1,31 @@
 #pragma once
 
+#include "AssetLoadReport.h"
 #include "DisplayModeInfo.h"
 #include "EngineDataTypes.h"
 #include "EngineResourcesDescriptions.h"
+#include "EngineTime.h"
+#include "GlyphAtlas.h"
 #include "IGameObject.h"
+#include "InputRecording.h"
+#include "ObjectAllocator.h"
+#include "RenderCache.h"
+#include "RenderCommandBuffer.h"
+#include "RenderQueue.h"
+#include "SceneStorage.h"
+#include "SpatialGrid.h"
 #include "Sprite.h"
 #include "Texture.h"
+#include "UIEvents.h"
 
 #include <array>
+#include <deque>
 #include <filesystem>
 #include <memory>
 #include <random>
 #include <SDL.h>
 #include <SDL_ttf.h>
 #include <unordered_map>
-#include <unordered_set>
 #include <vector>
 
 using namespace JadeEngine::detail;
@@ -269,9 +280,82 @@ namespace JadeEngine
     Vector2D_i32 GetMiddlePoint() const { return GetHalfSize(); };
 
     const Sprite* GetHoveredSprite() const { return _hoveredSprite; }
+
+    /**
+    Direct all mouse button, wheel and key UI events to the %game object, regardless of what is hovered, until released.
+
+    Typically used by widgets that are dragged or that should close when clicked outside. Capture ends automatically when the %game object is destroyed.
+
+    @see Game::ReleaseMouse, IGameObject::OnUIEvent
+    */
+    void CaptureMouse(IGameObject* gameObject) { _uiEvents.SetCaptor(gameObject); }
+
+    /**
+    End the mouse capture if it is held by the %game object.
+
+    @see Game::CaptureMouse
+    */
+    void ReleaseMouse(IGameObject* gameObject);
+    IGameObject* GetMouseCaptor() const { return _uiEvents.GetCaptor(); }
+
+    /**
+    Render the %game object together with all %game objects under its transform into a texture once and afterwards draw just that texture.
+
+    The texture is rendered again only after the transform, visibility, Z coordinate or looks of any of them changed, which suits
+    composite widgets that rarely change, such as buttons and panels. The subtree is drawn in place of its lowest member in the rendering order.
+    Subtrees containing %game objects in kRenderMode_Direct are rendered as usual. Call IGameObject::Invalidate of the %game object after
+    attaching one of its members elsewhere. The texture returns to a pool once caching is turned off or the %game object is destroyed.
+
+    @see IGameObject::Invalidate
+    */
+    void SetCachedAsTexture(IGameObject* gameObject, const bool cached);
+
+    /**
+    Return the number of the current frame's UI events dispatch.
+
+    Widgets can remember UIEvent::frame instead of clearing one-frame flags in an update, i.e. a button was pressed this frame if the frame of its press equals this number.
+    */
+    uint64_t GetUIEventFrame() const { return _uiEvents.GetFrame(); }
     SDL_Renderer* GetRenderer() { return _renderer; }
+
+    /**
+    Return the buffer %game objects in kRenderMode_Commands push their draws to from within IGameObject::Render.
+
+    Its RenderCommandBuffer::GetLastFrameStats reports how many draw calls and texture switches the batching saved.
+
+    @see RenderMode, RenderCommandBuffer
+    */
+    RenderCommandBuffer& GetRenderCommands() { return _renderCommands; }
     bool IsFullscreen() const { return _fullscreen; }
 
+    /**
+    Whether the %game runs without a window and renders offscreen.
+
+    @see GameInitParams::headless
+    */
+    bool IsHeadless() const { return _headless; }
+
+    /**
+    Return how far the current time is between the last fixed simulation step and the next one, in the range [0, 1).
+
+    %Game objects rendering from their previous and current state can blend them by this amount to move smoothly whatever the rendering rate.
+    Always 1 without a fixed simulation step as the state is then up to date with the current frame.
+
+    @see GameInitParams::fixedTimestep
+    */
+    float GetInterpolationAlpha() const;
+
+    /**
+    Show or hide an overlay with per-phase timings of the game loop, averaged over the last second.
+
+    The overlay lives in the persistent scene below the FPS counter. For programmatic access to the timings see GProfiler.
+
+    @param shown Whether the overlay should be visible.
+    @see Profiler, ProfilerPhase
+    */
+    void ShowProfilerOverlay(const bool shown);
+    bool IsProfilerOverlayShown() const;
+
     void SetDisplayMode(const int32_t index);
     const int32_t GetCurrentDisplayMode() const { return _currentMode; }
     const std::vector<DisplayModeInfo>& GetDisplayModes() const { return _displayModes; }
@@ -284,7 +368,7 @@ namespace JadeEngine
 
     The object will belong to the current scene unless kObjectLayer_Persistent_UI is specified in which case it will belong to special persistent scene.
 
-    When creating large amount of objects consider doing so between GGame.StartBatchCreate() and GGame.EndBatchCreate() block.
+    The object is inserted into the scene's RenderQueue, the cost of creation does not depend on the number of existing objects.
 
     @param params Creation structure. For the actual type and its description see the class's constructor or header.
     @returns Pointer to the newly created %game object. Game instance owns the %game object but it might not possible to look it up later. Storing the pointer is advised.
@@ -298,8 +382,37 @@ namespace JadeEngine
     template<typename Class, typename CreationStruct>
     std::add_pointer_t<Class> Create(const CreationStruct& params)
     {
-      const auto& scene = params.layer == kObjectLayer_Persistent_UI ? _persistentScene : _currentScene;
-      auto result = _gameObjects[scene].emplace_back(std::move(std::make_unique<Class>(params))).get();
+      const auto storageIndex = params.layer == kObjectLayer_Persistent_UI ? _persistentStorage : _currentStorage;
+      uint8_t capabilities = 0;
+
+      // Objects without their own Render, such as composites of other objects, do not need to interrupt batching
+      if constexpr (!std::is_same_v<decltype(&Class::Render), void (IGameObject::*)(SDL_Renderer*)>)
+      {
+        capabilities |= kObjectCapability_Renderable;
+      }
+
+      constexpr auto updatable = !std::is_same_v<decltype(&Class::Update), void (IGameObject::*)()>;
+      if constexpr (updatable)
+      {
+        capabilities |= kObjectCapability_Updatable;
+      }
+
+      if constexpr (!std::is_same_v<decltype(&Class::OnUIEvent), void (IGameObject::*)(UIEvent&)>)
+      {
+        capabilities |= kObjectCapability_UIEvents;
+      }
+
+      auto result = AddGameObject(storageIndex, AllocateGameObject<Class>(storageIndex, params), capabilities);
+
+      if constexpr (updatable)
+      {
+        _sceneStorages[storageIndex].updateScheduler.Add(result, &UpdateGameObjectsOfClass<Class>);
+      }
+
+      if ((capabilities & kObjectCapability_Renderable) == 0)
+      {
+        result->SetRenderMode(kRenderMode_None);
+      }
 
       // Some objects benefit from being loaded immediately in order to be positioned correctly in the same frame they were created
       if (result->GetLoadState() == kLoadState_Wanted)
@@ -307,18 +420,18 @@ namespace JadeEngine
         result->SetLoadState(result->Load(_renderer));
       }
 
+      auto& storage = _sceneStorages[storageIndex];
+
       if constexpr (std::is_base_of_v<Sprite, Class>)
       {
-        _sprites.insert(result);
+        const auto sprite = static_cast<Sprite*>(result);
+        storage.spatialGrids[sprite->GetLayer()].Insert(sprite, sprite->transform->GetTestingBox());
       }
 
-      if (!_batchCreate) SortGameObjectsRendering(scene);
+      storage.renderQueue.Insert(result);
       return static_cast<std::add_pointer_t<Class>>(result);
     }
 
-    void StartBatchCreate() { _batchCreate = true; }
-    void EndBatchCreate();
-
     const SpriteSheetDescription* GetSpriteSheetDescription(const std::string& name)
     {
       const auto result = _spriteSheets.find(name);
@@ -353,6 +466,15 @@ namespace JadeEngine
     */
     TTF_Font* FindFont(const std::string& fontName, const uint32_t size) const;
 
+    /**
+    Return the glyph cache for a font, creating it on the first use.
+    @param font Font as returned by Game::FindFont.
+    @returns Glyph atlas for the font or nullptr if the font is nullptr.
+    @see GlyphAtlas, Text
+    @warning Only useful when creating a complex custom text-based %game objects and should be seldom used. For usage see existing text objects such as Text.
+    */
+    GlyphAtlas* GetGlyphAtlas(TTF_Font* font);
+
     /**
     Find Texture instance given a texture name.
     @param textureName The texture identification string as defined in GameInitParamsTextureEntry when initializing the game.
@@ -366,7 +488,7 @@ namespace JadeEngine
     /**
     Create a new deep copy of Texture. Note that it is not possible to look-up this new texture later hence the return value should be captured.
 
-    Used for tinting and setting transparency of sprites as an unique instance is necessary otherwise such operations would change all sprites using this texture.
+    Used for changing sampling of sprites as an unique instance is necessary otherwise such operations would change all sprites using this texture.
 
     @param textureDesc Existing texture that can be obtained with Game::FindTexture.
     @param sampling Wanted texture sampling for the new texture.
@@ -379,52 +501,115 @@ namespace JadeEngine
 
     void DestroyCopyTexture(SDL_Texture* texture);
 
+    /**
+    Timings of the asset loading done in Game::Initialize.
+
+    Textures, sprite-sheets and cursors are decoded on worker threads while fonts and sounds load on the main thread.
+    Decoded images are uploaded on the main thread as soon as they are ready.
+
+    @see AssetLoadReport
+    */
+    const AssetLoadReport& GetAssetLoadReport() const { return _assetLoadReport; }
+
+    /**
+    Allocation counters of %game objects, per class and in total.
+
+    @see GameInitParams::objectAllocator
+    */
+    ObjectAllocatorStats GetObjectAllocatorStats() const { return _objectAllocator->GetStats(); }
+
   private:
+    friend struct detail::GameObjectDeleter;
+
+    template<typename Class, typename... Args>
+    GameObjectPtr AllocateGameObject(const size_t storageIndex, Args&&... args)
+    {
+      const auto& objectType = GetObjectTypeInfo<Class>();
+      const auto memory = _objectAllocator->Allocate(storageIndex, objectType);
+      GameObjectPtr result(new (memory) Class(std::forward<Args>(args)...));
+      result->_objectType = &objectType;
+      result->_sceneStorage = storageIndex;
+      return result;
+    }
+
+    IGameObject* AddGameObject(const size_t storageIndex, GameObjectPtr gameObject, const uint8_t capabilities);
     std::string AssetPathToAbsolute(const char* assetName);
+    void CompactSceneStorage(SceneStorage& storage);
     void CollectDisplayModes();
     bool CreateSolidColorTexture(const std::string& name, const int32_t width, const int32_t height, const SDL_Color& color);
     void DestroyGameObjects();
-    void GetBoundingBoxAndHitArray(SDL_Surface* surface, Rectangle& boundingBox, std::vector<bool>& hitArray, bool hitsRequired);
-    uint32_t GetPixel(SDL_Surface* surface, int32_t x, int32_t y);
+    void ReleaseGameObject(IGameObject* gameObject);
+    bool GetBoundingBoxAndHitMask(SDL_Surface* surface, Rectangle& boundingBox, std::shared_ptr<const HitMask>& hitMask, bool hitsRequired);
     std::string HashSolidColorTexture(const uint32_t width, const uint32_t height, const SDL_Color& color);
     void RegisterKeybindings(const GameInitParams& initParams);
     Sprite* GameObjectToSprite(IGameObject* gameObject);
     bool LoadAssets(const GameInitParams& initParams);
-    bool LoadCursor(const char* assetName, const char* textureFile, int32_t centerX, int32_t centerY);
+    bool CreateCursor(const char* assetName, SDL_Surface* imageSurface, int32_t centerX, int32_t centerY);
+    bool DecodeImage(const char* imageFile, const bool hitsRequired, DecodedImageDescription& image);
+    bool DecodeSpriteSheet(const char* assetName, const char* sheetFile, SpriteSheetDescription& spriteSheet);
     bool LoadFont(const std::vector<uint32_t>& sizes, const char* assetName, const char* fontFile);
-    bool LoadSpritesheet(const char* assetName, const char* textureFile, const char* sheetFile, const TextureSampling sampling);
-    bool LoadTexture(const char* assetName, const char* textureFile, const bool hitsRequired, const TextureSampling sampling);
+    bool PackTextures();
     void PlayScene(std::shared_ptr<IScene>& scene);
-    void RenderGameObjects(std::shared_ptr<IScene>& scene);
+    void ProcessEvent(const SDL_Event& event);
+    void RenderGameObjects(std::shared_ptr<IScene>& scene, const Rectangle* region);
     void SetHoveredSprite(Sprite* sprite);
-    void SortGameObjectsRendering(const std::shared_ptr<IScene>& scene);
     void Update();
+    void Simulate();
+    bool CollectRedraw(bool& fullRedraw);
+    void RenderFrame(const bool fullRedraw);
+    void InvalidateRenderCaches(IGameObject* gameObject);
+    bool TracksChanges() const { return _skipIdleFrames || _partialRedraw || !_renderCaches.empty(); }
+    void UpdateChangeTracking();
+    void RebuildRenderCaches(std::shared_ptr<IScene>& scene);
+    detail::RenderCache* FindRenderCache(IGameObject* gameObject);
+    IGameObject* TransformToGameObject(const Transform& transform) const;
     void LoadGameObjects(std::shared_ptr<IScene>& scene);
-    void HoverSprites(std::shared_ptr<IScene>& scene);
+    Sprite* HoverSprites(std::shared_ptr<IScene>& scene);
     void UpdateGameObjects(std::shared_ptr<IScene>& scene);
     void UpdateGameObjectsTransforms(std::shared_ptr<IScene>& scene);
     void UpdateKeybindings();
-    void DestroyGameObject(IGameObject* gameObject);
+    void UpdateProfilerOverlay(const size_t frames);
+    bool UploadTexture(const char* assetName, DecodedImageDescription& image, const TextureSampling sampling, const bool packable);
+    void RegisterScene(const std::shared_ptr<IScene>& scene);
 
     SDL_Window* _window;
     SDL_Renderer* _renderer;
     uint32_t _nativeTextureFormats;
     SDL_Texture* _nativeRenderBuffer;
 
+    // Target of the software renderer in headless mode, there is no window then
+    SDL_Surface* _headlessSurface;
+    bool _headless;
+    uint32_t _headlessFrames;
+    uint32_t _frames;
+
     std::shared_ptr<IScene> _currentScene;
     std::shared_ptr<IScene> _persistentScene;
     std::unordered_map<int32_t, std::shared_ptr<IScene>> _scenes;
 
-    std::unordered_map<std::shared_ptr<IScene>, std::vector<std::unique_ptr<IGameObject>>> _gameObjects;
-    std::unordered_set<IGameObject*> _sprites;
+    // Declared before the storages so it outlives the objects in them
+    std::shared_ptr<IObjectAllocator> _objectAllocator;
+    std::deque<SceneStorage> _sceneStorages;
+    size_t _currentStorage;
+    size_t _persistentStorage;
+    std::vector<IGameObject*> _pendingDestructions;
+
+    // %Game object owning the transform in each TransformSystem slot, stale entries are told apart by the transform's generation
+    std::vector<std::pair<Transform, IGameObject*>> _transformObjects;
+    UIEventRouter _uiEvents;
+    RenderCommandBuffer _renderCommands;
 
     std::unordered_map<std::string, FontDescription> _fonts;
+    std::unordered_map<TTF_Font*, std::unique_ptr<GlyphAtlas>> _glyphAtlases;
     std::unordered_map<std::string, std::shared_ptr<Texture>> _textures;
     std::vector<std::shared_ptr<Texture>> _textureCopies;
+    std::vector<SDL_Texture*> _textureAtlasPages;
+    std::vector<std::pair<std::shared_ptr<Texture>, SDL_Surface*>> _texturesToPack;
+    bool _packTextures;
+    AssetLoadReport _assetLoadReport;
     std::unordered_map<std::string, CursorDescription> _cursors;
     std::unordered_map<std::string, SpriteSheetDescription> _spriteSheets;
 
-    std::vector<Sprite*> _possibleSprites;
     Sprite* _hoveredSprite;
 
     SDL_Color _clearColor;
@@ -433,10 +618,40 @@ namespace JadeEngine
     float _fpsTimer;
     int _fpsCount;
 
+    FTC* _profilerText;
+
     std::mt19937 _re;
 
+    InputRecorder _inputRecorder;
+    InputReplay _inputReplay;
+    std::vector<SDL_Event> _replayedEvents;
+
     bool _quit;
 
+    float _fixedTimestep;
+    uint32_t _maxSimulationSteps;
+    float _accumulator;
+    bool _inputConsumed;
+    bool _unthrottled;
+    FramePacer _framePacer;
+
+    bool _skipIdleFrames;
+    uint32_t _idleFrameTimeout;
+    // Set by changes the render queues and transforms do not know about, e.g. window events
+    bool _redrawWanted;
+    IScene* _renderedScene;
+    SDL_Point _renderedCamera;
+
+    bool _partialRedraw;
+    // Changes collected for the next render, the transforms are gathered after every simulation step
+    std::vector<Transform> _redrawTransforms;
+    std::vector<IGameObject*> _redrawObjects;
+    std::vector<Rectangle> _redrawRegions;
+
+    std::unordered_map<IGameObject*, detail::RenderCache> _renderCaches;
+    RenderTargetPool _renderTargets;
+    std::vector<detail::RenderQueueEntry> _renderCacheMembers;
+
     int32_t _renderResolutionWidth;
     int32_t _renderResolutionHeight;
 
@@ -451,8 +666,6 @@ namespace JadeEngine
 
     std::unordered_map<int32_t, KeyBindingDescription> _keybindings;
 
-    bool _batchCreate;
-
     int32_t     _majorVersion;
     int32_t     _minorVersion;
     std::string _hashVersion;
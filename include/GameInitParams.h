@@ -7,9 +7,11 @@
 
 #pragma once
 
+#include "ObjectAllocator.h"
 #include "TextureSampling.h"
 
 #include <cstdint>
+#include <memory>
 #include <SDL_pixels.h>
 #include <string>
 #include <vector>
@@ -41,7 +43,7 @@ namespace JadeEngine
     Hit map simply remembers for each pixel of the texture whether it is opaque (alpha > 0).
     This is then be used in Sprite::HitTest method, for example when more precise action of clicking on an object is necessary.
 
-    Note that this processing can be expensive and has significant memory footprint per texture.
+    The hit map takes one bit per pixel and is shared by all copies of the texture.
 
     @see Sprite::HitTest
     */
@@ -272,7 +274,39 @@ namespace JadeEngine
     //int32_t minorVersion;
     1,
     //std::string hashVersion;
-    "4b825dc6"
+    "4b825dc6",
+    //bool packTextures;
+    true,
+    //bool deferTransformPropagation;
+    false,
+    //std::shared_ptr<IObjectAllocator> objectAllocator;
+    nullptr,
+    //std::string inputRecordingFile;
+    "",
+    //std::string inputReplayFile;
+    "",
+    //bool unthrottledReplay;
+    false,
+    //bool headless;
+    false,
+    //float headlessDeltaTime;
+    1.0f / 60.0f,
+    //uint32_t headlessFrames;
+    0,
+    //float fixedTimestep;
+    0.0f,
+    //uint32_t maxSimulationSteps;
+    5,
+    //uint32_t frameRateCap;
+    0,
+    //bool verticalSync;
+    true,
+    //bool skipIdleFrames;
+    false,
+    //uint32_t idleFrameTimeout;
+    100,
+    //bool partialRedraw;
+    false
   };
   @endcode
   */
@@ -436,5 +470,139 @@ namespace JadeEngine
     @see majorVersion, minorVersion
     */
     std::string hashVersion;
+
+    /**
+    Whether small textures from GameInitParams::textures and engine's own textures should be packed into shared atlas pages when loaded.
+
+    Sprites using textures from the same page can be drawn without switching textures which allows their draws to be batched.
+    Textures larger than kTextureAtlasMaxEntrySize in either dimension and sprite-sheets are never packed.
+
+    @see RenderCommandBuffer, Texture::source
+    */
+    bool packTextures;
+
+    /**
+    Whether moving or resizing a transform should only mark its attached descendants and move them once per frame before rendering, instead of immediately on every change.
+
+    Beneficial when transforms with deep attachments change several times per frame, for example animated composite %game objects. Reading a descendant's position in between still returns the up-to-date value.
+
+    @see TransformSystem::SetDeferredPropagation
+    */
+    bool deferTransformPropagation;
+
+    /**
+    Source of memory for %game objects created by Game::Create, nullptr for the default PoolObjectAllocator.
+
+    @see IObjectAllocator, Game::GetObjectAllocatorStats
+    */
+    std::shared_ptr<IObjectAllocator> objectAllocator;
+
+    /**
+    Path of a file to record the session's input into, empty to not record.
+
+    The file stores the SDL2 events polled every frame, each frame's delta time and the seed of the random number generator used by Game::RandomNumber.
+    Replayed via `inputReplayFile` it reproduces the session, provided the game only depends on those, for example as a repeatable benchmark.
+
+    @see InputRecorder, GameInitParams::inputReplayFile
+    */
+    std::string inputRecordingFile;
+
+    /**
+    Path of a file previously recorded via `inputRecordingFile` to play back instead of the real input, empty for a normal session.
+
+    The real input is ignored apart from closing the window and the %game quits once the recording ends.
+    The rendering resolution must match the recorded session. Mouse positions are stored in render coordinates,
+    the display mode and window size may differ, for example when replaying a windowed session in `headless` mode.
+
+    @see InputReplay, GameInitParams::unthrottledReplay
+    */
+    std::string inputReplayFile;
+
+    /**
+    Whether a replay should run as fast as possible, with vertical synchronization turned off. Each frame still uses its recorded delta time.
+
+    @see GameInitParams::inputReplayFile
+    */
+    bool unthrottledReplay;
+
+    /**
+    Whether to run without a window, audio device or vertical synchronization, for example on machines without a display.
+
+    %Game objects are rendered by the software renderer into an offscreen surface that is never presented
+    and every frame advances the time by `headlessDeltaTime` instead of the wall-clock time, as fast as the CPU allows.
+    Together with `headlessFrames` this allows simulations, soak tests and benchmarks to run thousands of frames in seconds.
+    The rendering resolution is the only display mode. Sessions recorded via `inputRecordingFile` at the same rendering resolution replay correctly
+    whatever window size they were recorded with, as mouse positions are stored in render coordinates.
+
+    @see GameInitParams::headlessDeltaTime, GameInitParams::headlessFrames, Game::IsHeadless
+    */
+    bool headless;
+
+    /**
+    Delta time in seconds of each frame in `headless` mode. Ignored while replaying, which uses the recorded delta times.
+    */
+    float headlessDeltaTime;
+
+    /**
+    Number of frames after which a `headless` session quits, 0 to run until Game::Quit is called.
+    */
+    uint32_t headlessFrames;
+
+    /**
+    Duration in seconds of a fixed simulation step, 0 to update once per rendered frame with that frame's delta time.
+
+    With a fixed step %game objects and scenes update as many times per frame as the time elapsed allows, each time with GTime.deltaTime equal to this step,
+    which makes the simulation independent of the rendering rate. Rendering can smooth out the remainder via Game::GetInterpolationAlpha.
+
+    @see GameInitParams::maxSimulationSteps
+    */
+    float fixedTimestep;
+
+    /**
+    Maximum number of fixed simulation steps per rendered frame. Time beyond that is dropped, the %game slows down rather than falling further behind.
+    */
+    uint32_t maxSimulationSteps;
+
+    /**
+    Maximum number of frames per second, 0 for no cap. Waits precisely at the end of a frame, which is most useful with `verticalSync` turned off.
+
+    Ignored in `headless` mode and during an unthrottled replay.
+
+    @see FramePacer
+    */
+    uint32_t frameRateCap;
+
+    /**
+    Whether presenting a frame waits for the display's vertical synchronization.
+    */
+    bool verticalSync;
+
+    /**
+    Whether frames in which nothing visible changed should be neither rendered nor presented.
+
+    Instead of rendering the same picture again the %game waits for the next input event, at most `idleFrameTimeout` milliseconds,
+    which brings CPU and GPU use of still screens such as menus close to zero. Changes of transforms, visibility, Z coordinates, sprites, texts,
+    the world camera, the scene and the window are noticed automatically, custom IGameObject::Render implementations have to call IGameObject::Invalidate.
+
+    Ignored in `headless` mode and during a replay.
+    */
+    bool skipIdleFrames;
+
+    /**
+    Longest time in milliseconds an idle frame waits for input, this is how often %game objects keep updating while nothing happens on screen.
+    With a `fixedTimestep` it is shortened to what `maxSimulationSteps` can catch up on.
+    */
+    uint32_t idleFrameTimeout;
+
+    /**
+    Whether only the parts of the screen that changed should be drawn again instead of the whole frame.
+
+    The rendering target keeps the previous frame. Each frame the areas of the %game objects whose transform, visibility or looks changed,
+    both where they were and where they are now, are merged into regions and only those are cleared and rendered, clipped to each region.
+    A full redraw happens when the scene, the world camera or the window changes or when the regions would cover too much of the screen.
+
+    Requires every %game object to report where it draws via IGameObject::GetRenderBounds and its changes via IGameObject::Invalidate.
+    */
+    bool partialRedraw;
   };
 }
@@ -0,0 +1,109 @@
+#pragma once
+
+#include "EngineDataTypes.h"
+#include "RenderCommandBuffer.h"
+
+#include <cstdint>
+#include <SDL.h>
+#include <SDL_ttf.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace JadeEngine
+{
+  /**
+  Size in pixels of a single glyph atlas page texture.
+  */
+  const int32_t kGlyphAtlasPageSize = 512;
+
+  /**
+  Single glyph of laid out text, destination is relative to the text's top-left corner.
+  */
+  struct GlyphQuad
+  {
+    SDL_Texture*  texture;
+    Rectangle     source;
+    Rectangle     destination;
+  };
+
+  /**
+  Result of GlyphAtlas::Layout, ready to be rendered with GlyphAtlas::Render.
+  */
+  struct TextLayout
+  {
+    std::vector<GlyphQuad>  quads;
+    int32_t                 width;
+    int32_t                 height;
+  };
+
+  namespace detail
+  {
+    struct GlyphAtlasEntry
+    {
+      SDL_Texture*  texture;
+      Rectangle     source;
+      int32_t       offsetX;
+      int32_t       advance;
+    };
+
+    struct GlyphAtlasPage
+    {
+      SDL_Texture*  texture;
+      int32_t       size;
+      int32_t       cursorX;
+      int32_t       cursorY;
+    };
+  }
+
+  /**
+  Cache of rasterized glyphs of a single font and size.
+
+  Glyphs are rasterized in white the first time they are needed and packed into page textures.
+  Text is then rendered as a series of quads from these pages with color modulation, so changing text or its color does not rasterize anything.
+  Glyphs are pushed as render commands so all texts using the same font can be drawn without texture switches.
+  Text is expected to be UTF-8, code points outside of Basic Multilingual Plane are not supported by SDL2 TTF and are replaced.
+
+  @see Game::GetGlyphAtlas, Text, TextBox
+  */
+  class GlyphAtlas
+  {
+  public:
+    GlyphAtlas(SDL_Renderer* renderer, TTF_Font* font);
+    ~GlyphAtlas();
+
+    GlyphAtlas(const GlyphAtlas&) = delete;
+    GlyphAtlas& operator=(const GlyphAtlas&) = delete;
+
+    /**
+    Lay out UTF-8 text into glyph quads.
+
+    @param text UTF-8 encoded text.
+    @param wrapWidth Maximum width of a line in pixels, words exceeding it are moved to the next line. 0 to disable wrapping.
+    @param layout Output layout, previous content is replaced.
+    */
+    void Layout(const std::string& text, const int32_t wrapWidth, TextLayout& layout);
+
+    /**
+    Render previously laid out text by pushing a command for every glyph.
+
+    @param mask If not nullptr, only parts of glyphs inside this rectangle are rendered.
+    */
+    static void Render(RenderCommandBuffer& commands, const TextLayout& layout, const int32_t x, const int32_t y, const SDL_Color& color, const Rectangle* mask);
+
+  private:
+    const detail::GlyphAtlasEntry& FindGlyph(const uint16_t codePoint);
+    bool RasterizeGlyph(const uint16_t codePoint, detail::GlyphAtlasEntry& entry);
+    detail::GlyphAtlasPage* AllocatePageSpace(const int32_t width, const int32_t height, Rectangle& source);
+    int32_t GetKerning(const uint16_t previous, const uint16_t current) const;
+
+    SDL_Renderer* _renderer;
+    TTF_Font* _font;
+    int32_t _fontHeight;
+    int32_t _lineSkip;
+    bool _kerning;
+
+    std::unordered_map<uint16_t, detail::GlyphAtlasEntry> _glyphs;
+    std::vector<detail::GlyphAtlasPage> _pages;
+  };
+}
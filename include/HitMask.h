@@ -0,0 +1,75 @@
+#pragma once
+
+#include "EngineDataTypes.h"
+
+#include <cstdint>
+#include <memory>
+#include <SDL.h>
+#include <vector>
+
+namespace JadeEngine
+{
+  /**
+  Immutable per-pixel opacity of a texture, a pixel is a hit if its alpha is > 0.
+
+  Pixels are stored row-major as bits in 64-bit words, every row starting at a new word.
+  On top of that the mask keeps a coarse map of kHitMaskTileSize x kHitMaskTileSize tiles which are either empty, full or mixed so most tests are resolved without touching the bits.
+
+  Masks are shared between a texture and all its copies.
+
+  @see Texture::hitMask, Sprite::HitTest, GameInitParamsTextureEntry::generateHitMap
+  */
+  class HitMask
+  {
+  public:
+    /**
+    Build a mask from the alpha channel of a surface.
+
+    @param surface Any surface format, surfaces without alpha channel are completely opaque.
+    @returns nullptr if the surface could not be converted to a format with alpha channel.
+    */
+    static std::shared_ptr<const HitMask> Create(SDL_Surface* surface);
+
+    /**
+    Whether the pixel is opaque. Pixels outside of the mask are never hits.
+    */
+    bool Test(const int32_t x, const int32_t y) const;
+
+    int32_t GetWidth() const { return _width; }
+    int32_t GetHeight() const { return _height; }
+
+    /**
+    Smallest rectangle containing all opaque pixels, in the same form Game used for textures' bounding boxes: width and height are the distance between the first and the last opaque pixel.
+    */
+    const Rectangle& GetOpaqueBounds() const { return _opaqueBounds; }
+
+    /**
+    Size of the bits and the tile map in bytes.
+    */
+    size_t GetMemoryUsage() const;
+
+    HitMask(const int32_t width, const int32_t height);
+
+  private:
+    enum TileOccupancy : uint8_t
+    {
+      kTileOccupancy_Empty,
+      kTileOccupancy_Full,
+      kTileOccupancy_Mixed,
+    };
+
+    void BuildRows(SDL_Surface* surface);
+    void BuildTiles();
+    void BuildOpaqueBounds();
+
+    int32_t _width;
+    int32_t _height;
+    size_t _wordsPerRow;
+    std::vector<uint64_t> _bits;
+
+    int32_t _tilesPerRow;
+    std::vector<TileOccupancy> _tiles;
+
+    Rectangle _opaqueBounds;
+  };
+}
@@ -1,14 +1,20 @@
 #pragma once
 
+#include "RenderQueue.h"
 #include "Transform.h"
+#include "UpdateScheduler.h"
 
 #include <cstdint>
 #include <memory>
+#include <vector>
 
 struct SDL_Renderer;
 
 namespace JadeEngine
 {
+  struct ObjectTypeInfo;
+  struct UIEvent;
+
   /**
   Enumeration for state of loading a %game object is currently in.
   */
@@ -38,6 +44,114 @@ namespace JadeEngine
     kLoadState_Abandoned,
   };
 
+  /**
+  Enumeration for how a %game object's Render function draws.
+
+  @see IGameObject::SetRenderMode, RenderCommandBuffer
+  */
+  enum RenderMode
+  {
+    /**
+    Render draws with the SDL2 renderer directly. All buffered render commands are drawn before Render is called so the order is kept.
+    */
+    kRenderMode_Direct,
+
+    /**
+    Render only pushes commands to Game::GetRenderCommands and never uses the SDL2 renderer directly, which allows the commands to be batched with other %game objects.
+    */
+    kRenderMode_Commands,
+
+    /**
+    The %game object does not render anything itself and its Render function is never called.
+
+    Set automatically by Game::Create for %game objects that do not override IGameObject::Render.
+    */
+    kRenderMode_None,
+  };
+
+  /**
+  Flags describing which engine passes a %game object can take part in.
+
+  Set once when the %game object is created so the passes can skip objects without calling into them.
+
+  @see IGameObject::HasCapability, Game::Create
+  */
+  enum ObjectCapability : uint8_t
+  {
+    /**
+    The %game object overrides IGameObject::Render.
+    */
+    kObjectCapability_Renderable = 1 << 0,
+
+    /**
+    The %game object overrides IGameObject::Update.
+    */
+    kObjectCapability_Updatable = 1 << 1,
+
+    /**
+    The %game object is a Sprite or derives from it.
+    */
+    kObjectCapability_Sprite = 1 << 2,
+
+    /**
+    The %game object is a Sprite whose texture has a hit map.
+
+    @see Sprite::HasHitTest
+    */
+    kObjectCapability_HitTestable = 1 << 3,
+
+    /**
+    The %game object overrides IGameObject::OnUIEvent.
+    */
+    kObjectCapability_UIEvents = 1 << 4,
+  };
+
+  /**
+  Specifies how often the Update function of an updatable %game object is called.
+
+  @see IGameObject::SetUpdatePolicy, UpdateScheduler
+  */
+  enum UpdatePolicy
+  {
+    /**
+    Update is called every frame. The default.
+    */
+    kUpdatePolicy_EveryFrame,
+
+    /**
+    Update is called every N-th frame, N being the interval passed to IGameObject::SetUpdatePolicy, and additionally whenever the %game object is woken.
+    */
+    kUpdatePolicy_EveryNthFrame,
+
+    /**
+    Update is only called in the frame after the %game object was woken, either explicitly or by one of its WakeEvent flags.
+    */
+    kUpdatePolicy_OnWake,
+
+    /**
+    Update is never called.
+    */
+    kUpdatePolicy_Never,
+  };
+
+  /**
+  Events which wake a %game object with kUpdatePolicy_OnWake or kUpdatePolicy_EveryNthFrame.
+
+  @see IGameObject::SetWakeEvents
+  */
+  enum WakeEvent : uint8_t
+  {
+    /**
+    A property of the %game object's transform changed, Transform::IsDirty will be true in the Update it is woken for.
+    */
+    kWakeEvent_TransformDirty = 1 << 0,
+
+    /**
+    The mouse cursor started or stopped hovering over the %game object. Only Sprite based %game objects can be hovered.
+    */
+    kWakeEvent_HoverChange = 1 << 1,
+  };
+
   /**
   Interface for %game objects.
 
@@ -82,20 +196,46 @@ namespace JadeEngine
     Default constructor for %game object.
     */
     IGameObject()
-      : transform(std::make_shared<Transform>())
+      : transform(GTransformSystem.Create())
       , _loadState(kLoadState_Done)
       , _shown(true)
       , _z(0)
       , _destructionWanted(false)
+      , _renderMode(kRenderMode_Direct)
+      , _capabilities(0)
+      , _renderQueue(nullptr)
+      , _renderOrder(0)
+      , _invalidated(false)
+      , _invalidatedIndex(0)
+      , _renderedBounds{ 0, 0, 0, 0 }
+      , _renderCacheRoot(false)
+      , _destructionQueue(nullptr)
+      , _sceneStorage(0)
+      , _sceneSlot(0)
+      , _objectType(nullptr)
+      , _updatePolicy(kUpdatePolicy_EveryFrame)
+      , _updateInterval(1)
+      , _wakeEvents(0)
+      , _updateScheduler(nullptr)
+      , _scheduleSlot(UINT32_MAX)
     {
     }
 
+    /**
+    Releases the %game object's transform.
+    */
+    virtual ~IGameObject()
+    {
+      GTransformSystem.Destroy(transform);
+    }
+
     /**
     Triggered every frame while the scene that owns this %game object is active and the %game object was successfully loaded.
 
     The trigger order is the following: IScene::PreUpdate -> IGameObject::Load -> IGameObject::Update -> IScene::Update -> IGameObject::Load -> IGameObject::Render.
 
     To obtain delta time since last frame use GTime.deltaTime.
+    %Game objects of the same class are updated in the order they were created, classes in the order their first object was created in the scene.
     @see Time, LoadState, IGameObject::Render, IScene::Update, IScene::PreUpdate
     */
     virtual void Update() {};
@@ -130,6 +270,101 @@ namespace JadeEngine
     */
     virtual void Render(SDL_Renderer* renderer) {};
 
+    /**
+    Triggered when an input event concerns the %game object: the mouse started or stopped hovering it, or a button, wheel or key was used while it, one of its children or its descendant sprite was hovered or while it captured the mouse.
+
+    Events are dispatched after IGameObject::Load and before IGameObject::Update so the whole frame sees the same state.
+    Press, Release, Wheel and Key events are received by the ancestors of the target both on their way down and back up, see UIEventPhase.
+    Set UIEvent::handled to stop the event from reaching the rest of them.
+
+    @see UIEvent, UIEventRouter, Game::CaptureMouse
+    */
+    virtual void OnUIEvent(UIEvent& event) {};
+
+    /**
+    Return how the %game object's Render function draws.
+    @see RenderMode
+    */
+    RenderMode GetRenderMode() const { return _renderMode; }
+
+    /**
+    Whether the %game object and its subtree are drawn from a texture.
+    @see Game::SetCachedAsTexture
+    */
+    bool IsCachedAsTexture() const { return _renderCacheRoot; }
+
+    /**
+    Declare how the %game object's Render function draws. Defaults to kRenderMode_Direct which is always correct but prevents batching.
+    @see RenderMode
+    */
+    void SetRenderMode(const RenderMode mode) { _renderMode = mode; }
+
+    /**
+    Return whether the %game object has a capability.
+    @see ObjectCapability
+    */
+    bool HasCapability(const ObjectCapability capability) const { return (_capabilities & capability) != 0; }
+
+    /**
+    Return all capabilities of the %game object as ObjectCapability flags.
+    */
+    uint8_t GetCapabilities() const { return _capabilities; }
+
+    /**
+    Declare how often Update should be called. Sleeping %game objects cost nothing per frame.
+
+    Switching to kUpdatePolicy_OnWake calls Update once more so the %game object can settle before it falls asleep.
+    Has no effect on %game objects that do not override Update.
+
+    @param interval Number of frames between updates for kUpdatePolicy_EveryNthFrame.
+    @see UpdatePolicy, Wake, SetWakeEvents
+    */
+    void SetUpdatePolicy(const UpdatePolicy policy, const uint32_t interval = 1)
+    {
+      _updatePolicy = policy;
+      _updateInterval = interval;
+      if (_updateScheduler != nullptr)
+      {
+        _updateScheduler->OnPolicyChanged(this);
+      }
+    }
+
+    UpdatePolicy GetUpdatePolicy() const { return _updatePolicy; }
+
+    /**
+    Set which WakeEvent flags wake the %game object.
+    */
+    void SetWakeEvents(const uint8_t wakeEvents) { _wakeEvents = wakeEvents; }
+
+    /**
+    Return whether the WakeEvent wakes the %game object.
+    */
+    bool WakesOn(const WakeEvent wakeEvent) const { return (_wakeEvents & wakeEvent) != 0; }
+
+    /**
+    Have Update called once, in the current frame if the scene's %game objects were not updated yet or else in the next one.
+
+    Only affects %game objects with kUpdatePolicy_OnWake or kUpdatePolicy_EveryNthFrame.
+    */
+    void Wake()
+    {
+      if (_updateScheduler != nullptr)
+      {
+        _updateScheduler->Wake(this);
+      }
+    }
+
+    /**
+    Wake the %game object once the scene it belongs to has been updated for the given time.
+    */
+    void WakeAfter(const float seconds)
+    {
+      if (_updateScheduler != nullptr)
+      {
+        _updateScheduler->WakeAfter(this, seconds);
+      }
+    }
+
     /**
     Return the current load state of the %game object.
     @see LoadState
@@ -167,19 +402,80 @@ namespace JadeEngine
 
     @see IGameObject::IsShown
     */
-    virtual void Show(const bool show) { _shown = show; }
+    virtual void Show(const bool show)
+    {
+      if (_shown != show)
+      {
+        _shown = show;
+        Invalidate();
+      }
+    }
+
+    /**
+    Tell the engine the %game object looks different than when it was last rendered.
+
+    Changes of the transform, visibility, Z coordinate and loading are noticed automatically. Implementations of IGameObject::Render
+    should call this whenever any other state they draw from changes, otherwise the change might not be shown while GameInitParams::skipIdleFrames is on.
+    */
+    void Invalidate()
+    {
+      if (_renderQueue != nullptr)
+      {
+        _renderQueue->Invalidate(this);
+      }
+    }
+
+    /**
+    Return the area of the rendering target the %game object draws into, by default the box of its transform.
+
+    Used to redraw only the changed parts of the screen while GameInitParams::partialRedraw is on.
+    Implementations of IGameObject::Render drawing outside of the transform's box must override it.
+    */
+    virtual Rectangle GetRenderBounds() const
+    {
+      return { transform->GetX(), transform->GetY(), transform->GetWidth(), transform->GetHeight() };
+    }
 
     /**
     Returns Z coordinate. The %game objects with higher Z coordinate will be drawn over the ones with lower one.
     */
     int32_t GetZ() const { return _z; }
 
+    /**
+    Change Z coordinate. The change is reflected in the rendering order immediately.
+
+    @warning Children %game objects are not affected. Should not be called from within IGameObject::Render.
+    @see IGameObject::GetZ
+    */
+    void SetZ(const int32_t z)
+    {
+      if (_z != z)
+      {
+        const auto oldZ = _z;
+        _z = z;
+        if (_renderQueue != nullptr)
+        {
+          _renderQueue->Rekey(this, oldZ);
+        }
+      }
+    }
+
     /**
     Mark the object to be destroyed.
 
     At the begging of the next frame its Clean function will be called and the %game object will removed from list of game objects.
     */
-    void Destroy() { _destructionWanted = true; }
+    void Destroy()
+    {
+      if (!_destructionWanted)
+      {
+        _destructionWanted = true;
+        if (_destructionQueue != nullptr)
+        {
+          _destructionQueue->push_back(this);
+        }
+      }
+    }
 
     /**
     Returns whether the object is marked for destruction.
@@ -187,17 +483,42 @@ namespace JadeEngine
     bool DestructionWanted() const { return _destructionWanted; }
 
     /**
-    Transform of the %game object.
+    Transform of the %game object, a handle to the data stored in GTransformSystem.
 
     @see Transform
     */
-    const std::shared_ptr<Transform> transform;
+    const Transform transform;
 
   protected:
+    void AddCapabilities(const uint8_t capabilities) { _capabilities |= capabilities; }
+
     LoadState _loadState;
     bool      _shown;
     int32_t   _z;
   private:
-    bool      _destructionWanted;
+    friend class Game;
+    friend class RenderQueue;
+    friend class UpdateScheduler;
+
+    bool          _destructionWanted;
+    RenderMode    _renderMode;
+    uint8_t       _capabilities;
+    RenderQueue*  _renderQueue;
+    uint64_t      _renderOrder;
+    bool          _invalidated;
+    size_t        _invalidatedIndex;
+    // Area covered when last rendered, only tracked while GameInitParams::partialRedraw is on
+    Rectangle     _renderedBounds;
+    bool          _renderCacheRoot;
+
+    std::vector<IGameObject*>*  _destructionQueue;
+    size_t                      _sceneStorage;
+    size_t                      _sceneSlot;
+    const ObjectTypeInfo*       _objectType;
+    UpdatePolicy                _updatePolicy;
+    uint32_t                    _updateInterval;
+    uint8_t                     _wakeEvents;
+    UpdateScheduler*            _updateScheduler;
+    uint32_t                    _scheduleSlot;
   };
 }
\ No newline at end of file
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+
 namespace JadeEngine
 {
   class Sprite;
@@ -123,8 +125,21 @@ namespace JadeEngine
     @warning Used internally by the Jade Engine and there is very little reason to call this as a user.
     */
     void SetActive(const bool active) { _active = active; }
+
+    /**
+    Returns index of the storage of the scene's %game objects inside Game, SIZE_MAX if the scene was not added yet.
+    @warning Used internally by the Jade Engine and there is very little reason to call this as a user.
+    */
+    size_t GetStorageIndex() const { return _storageIndex; }
+
+    /**
+    Set index of the storage of the scene's %game objects inside Game.
+    @warning Used internally by the Jade Engine and there is very little reason to call this as a user.
+    */
+    void SetStorageIndex(const size_t index) { _storageIndex = index; }
   private:
     bool _initialized = false;
     bool _active = false;
+    size_t _storageIndex = SIZE_MAX;
   };
 }
\ No newline at end of file
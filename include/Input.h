@@ -1,15 +1,24 @@
 #pragma once
 
+#include <array>
+#include <cstdint>
 #include <SDL.h>
-#include <unordered_map>
+#include <string>
+#include <vector>
 
 namespace JadeEngine
 {
-  enum KeyState
+  const size_t kMouseButtonSlots = 8;
+  const size_t kAsciiKeycodes = 128;
+
+  /**
+  Flags of a key or mouse button state. Pressed and Released are edges that only last for the frame the change happened in.
+  */
+  enum KeyStateFlag : uint8_t
   {
-    kKeyState_Up,
-    kKeyState_Pressed,
-    kKeyState_Down
+    kKeyStateFlag_Down = 1 << 0,
+    kKeyStateFlag_Pressed = 1 << 1,
+    kKeyStateFlag_Released = 1 << 2,
   };
 
   class Input
@@ -17,31 +26,43 @@ namespace JadeEngine
   public:
     Input();
     void ProcessMessage(const SDL_Event& event);
+    void AfterMessages();
     void Update();
     void AfterUpdate();
 
-    bool KeyDown(SDL_Keycode key);
-    bool KeyPressed(SDL_Keycode key);
+    void RefreshKeymap();
+    void SetKeybind(const int32_t keybind, const SDL_Keycode key);
+
+    /**
+    Whether mouse positions of processed messages are already in render coordinates, as replayed by InputReplay, instead of window coordinates.
+    */
+    void SetMouseInRenderCoordinates(const bool renderCoordinates) { _mouseInRenderCoordinates = renderCoordinates; }
 
-    bool KeybindDown(const int32_t keybind);
-    bool KeybindPressed(const int32_t keybind);
+    bool KeyDown(SDL_Keycode key) const;
+    bool KeyPressed(SDL_Keycode key) const;
+    bool KeyReleased(SDL_Keycode key) const;
+
+    bool KeybindDown(const int32_t keybind) const;
+    bool KeybindPressed(const int32_t keybind) const;
 
     template <typename T>
-    bool KeybindPressed(const T keybind)
+    bool KeybindPressed(const T keybind) const
     {
       return KeybindPressed(static_cast<int32_t>(keybind));
     }
 
     template <typename T>
-    bool KeybindDown(const T keybind)
+    bool KeybindDown(const T keybind) const
     {
       return KeybindDown(static_cast<int32_t>(keybind));
     }
 
-    bool MouseButtonDown(int32_t key);
-    bool MouseButtonPressed(int32_t key);
+    bool MouseButtonDown(int32_t key) const;
+    bool MouseButtonPressed(int32_t key) const;
+    bool MouseButtonReleased(int32_t key) const;
 
     SDL_Keycode FirstKeyPressed() const;
+    const std::vector<SDL_Keycode>& GetPressedKeys() const { return _pressedKeys; }
     std::string GetKeyName(SDL_Keycode key) const;
 
     int32_t GetMouseX() const;
@@ -53,17 +74,42 @@ namespace JadeEngine
     int32_t GetMouseWheelY() const { return _mouseWheelY; }
 
   private:
-    std::unordered_map<SDL_Keycode, KeyState> _keyStates;
-    std::unordered_map<int32_t, KeyState> _mouseButtonStates;
+    SDL_Scancode ToScancode(const SDL_Keycode key) const;
+    uint8_t ScancodeState(const SDL_Scancode scancode) const;
+    uint8_t KeybindState(const int32_t keybind) const;
+    uint8_t MouseButtonState(const int32_t button) const;
+    void SetMouseWindowPosition(const int32_t x, const int32_t y);
+
+    // Indexed by scancode and by SDL button index
+    std::array<uint8_t, SDL_NUM_SCANCODES> _keyStates;
+    std::array<uint8_t, kMouseButtonSlots> _mouseButtonStates;
+
+    // Keys and buttons with edge flags set this frame, the only ones AfterUpdate has to visit
+    std::vector<SDL_Scancode> _changedKeys;
+    uint8_t _changedMouseButtons;
+
+    // Scancodes of keycodes of printable ASCII characters which depend on the keyboard layout
+    std::array<SDL_Scancode, kAsciiKeycodes> _asciiScancodes;
+
+    // Indexed by keybinding setting ID
+    std::vector<SDL_Keycode> _keybindKeys;
+    std::vector<SDL_Scancode> _keybindScancodes;
 
     int32_t _lastMouseX;
     int32_t _lastMouseY;
     int32_t _mouseX;
     int32_t _mouseY;
 
+    // Last reported position in window coordinates, converted only once after all messages of the frame were processed
+    int32_t _windowMouseX;
+    int32_t _windowMouseY;
+    bool _mouseMoved;
+    bool _mouseInRenderCoordinates;
+
     int32_t _mouseWheelY;
 
     SDL_Keycode _firstKeyPressed;
+    std::vector<SDL_Keycode> _pressedKeys;
   };
 
   extern Input GInput;
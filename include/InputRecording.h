@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <SDL.h>
+#include <string>
+#include <vector>
+
+namespace JadeEngine
+{
+  /**
+  Writes the SDL2 events polled by the game loop together with each frame's delta time into a compact binary file.
+
+  Together with the random number generator seed stored in the file header this is everything InputReplay needs to play the session again frame by frame.
+  Only the events the engine reacts to are stored: quit, keyboard, mouse motion, buttons and wheel and keymap changes.
+  Mouse positions are converted to render coordinates so a replay does not depend on the window size or display mode.
+
+  @see GameInitParams::inputRecordingFile, InputReplay
+  */
+  class InputRecorder
+  {
+  public:
+    InputRecorder();
+
+    bool Open(const std::string& path, const uint32_t seed, const int32_t width, const int32_t height);
+    bool IsOpen() const { return _file.is_open(); }
+
+    void BeginFrame(const float deltaTime);
+    void Record(const SDL_Event& event);
+
+    /**
+    Write the frame's delta time and the events recorded since BeginFrame.
+    */
+    void EndFrame();
+
+  private:
+    std::ofstream _file;
+    std::vector<uint8_t> _frame;
+    uint16_t _frameEvents;
+  };
+
+  /**
+  Reads a file written by InputRecorder and hands out its frames in order.
+
+  @see GameInitParams::inputReplayFile, InputRecorder
+  */
+  class InputReplay
+  {
+  public:
+    InputReplay();
+
+    /**
+    Open the recording, fails if the file is not a recording or was made with a different rendering resolution.
+    */
+    bool Open(const std::string& path, const int32_t width, const int32_t height);
+    bool IsOpen() const { return _file.is_open(); }
+
+    uint32_t GetSeed() const { return _seed; }
+
+    /**
+    Read the next frame, returns false once the recording ended.
+    */
+    bool NextFrame(float& deltaTime, std::vector<SDL_Event>& events);
+
+  private:
+    std::ifstream _file;
+    uint32_t _seed;
+  };
+}
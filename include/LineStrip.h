@@ -79,6 +79,7 @@ namespace JadeEngine
 
     void Render(SDL_Renderer* renderer) override;
     void Update() override;
+    Rectangle GetRenderBounds() const override;
 
     /**
     Changed the points that define the LineStrip. The LineScript will now consist of `points.size()-1` lines.
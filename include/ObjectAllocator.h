@@ -0,0 +1,198 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <typeinfo>
+#include <vector>
+
+namespace JadeEngine
+{
+  /**
+  Size, alignment and identifier of a %game object class, shared by all objects of the class.
+
+  @see IObjectAllocator
+  */
+  struct ObjectTypeInfo
+  {
+    /**
+    Small sequential number unique to the class, suitable for indexing.
+    */
+    uint32_t id;
+    size_t size;
+    size_t alignment;
+    const char* name;
+  };
+
+  /**
+  Allocation counters of a single %game object class.
+  */
+  struct ObjectTypeAllocationStats
+  {
+    const char* name;
+    size_t objectSize;
+    uint32_t liveObjects;
+    uint32_t peakObjects;
+    uint64_t allocations;
+
+    /**
+    Number of allocations served by memory of a previously destroyed object of the same class.
+    */
+    uint64_t reusedAllocations;
+  };
+
+  /**
+  Allocation counters of an IObjectAllocator.
+
+  @see Game::GetObjectAllocatorStats
+  */
+  struct ObjectAllocatorStats
+  {
+    /**
+    Memory obtained from the system, including memory not occupied by any object.
+    */
+    size_t reservedBytes;
+
+    /**
+    Memory occupied by objects which are alive or whose memory waits for reuse.
+    */
+    size_t usedBytes;
+
+    uint32_t liveObjects;
+    uint64_t allocations;
+    uint64_t deallocations;
+
+    /**
+    Counters of each class which was allocated at least once, indexed by ObjectTypeInfo::id.
+    */
+    std::vector<ObjectTypeAllocationStats> types;
+  };
+
+  /**
+  Interface of the memory source of %game objects created by Game::Create.
+
+  Every scene has its own arena, identified by IScene::GetStorageIndex, and an object is always released into the arena it was allocated from.
+  Once the last object of a scene was released the whole arena can be reset at once.
+
+  @see GameInitParams::objectAllocator, PoolObjectAllocator
+  */
+  class IObjectAllocator
+  {
+  public:
+    virtual ~IObjectAllocator() {}
+
+    /**
+    Allocate memory for a single object of the type.
+    */
+    virtual void* Allocate(const size_t arena, const ObjectTypeInfo& type) = 0;
+
+    /**
+    Release memory of an already destructed object previously allocated from the same arena.
+    */
+    virtual void Deallocate(const size_t arena, const ObjectTypeInfo& type, void* memory) = 0;
+
+    /**
+    Release all memory of the arena. All of its objects must have been deallocated.
+    */
+    virtual void ResetArena(const size_t arena) = 0;
+
+    virtual ObjectAllocatorStats GetStats() const = 0;
+  };
+
+  namespace detail
+  {
+    uint32_t RegisterObjectType();
+
+    template<typename Class>
+    const ObjectTypeInfo& GetObjectTypeInfo()
+    {
+      static const ObjectTypeInfo info = { RegisterObjectType(), sizeof(Class), alignof(Class), typeid(Class).name() };
+      return info;
+    }
+
+    /**
+    Counters shared by the engine's allocators.
+    */
+    class ObjectAllocationCounters
+    {
+    public:
+      ObjectAllocationCounters();
+
+      void OnAllocate(const ObjectTypeInfo& type, const bool reused);
+      void OnDeallocate(const ObjectTypeInfo& type);
+      void Fill(ObjectAllocatorStats& stats) const;
+
+    private:
+      uint64_t _allocations;
+      uint64_t _deallocations;
+      std::vector<ObjectTypeAllocationStats> _types;
+    };
+
+    struct ObjectPool
+    {
+      std::vector<std::unique_ptr<uint8_t[]>> blocks;
+      size_t blockSize = 0;
+      size_t blockUsed = 0;
+
+      // Intrusive list of released objects' memory
+      void* freeList = nullptr;
+    };
+
+    struct ObjectArena
+    {
+      // Indexed by ObjectTypeInfo::id
+      std::vector<ObjectPool> pools;
+      size_t reservedBytes = 0;
+      size_t usedBytes = 0;
+      uint32_t liveObjects = 0;
+    };
+  }
+
+  /**
+  Default allocator of %game objects.
+
+  Each scene arena has a pool per class which hands out memory from its own blocks in creation order, objects of a class in a scene are therefore next to each other.
+  The first block of a pool is small and each following one is twice as large, up to kObjectArenaBlockSize.
+  Memory of a destroyed object is kept on a free list of its pool and reused by the next object of the same class.
+  Resetting an arena releases its blocks without visiting the objects that were in them.
+
+  @see kObjectArenaBlockSize
+  */
+  class PoolObjectAllocator : public IObjectAllocator
+  {
+  public:
+    PoolObjectAllocator() = default;
+
+    PoolObjectAllocator(const PoolObjectAllocator&) = delete;
+    PoolObjectAllocator& operator=(const PoolObjectAllocator&) = delete;
+
+    void* Allocate(const size_t arena, const ObjectTypeInfo& type) override;
+    void Deallocate(const size_t arena, const ObjectTypeInfo& type, void* memory) override;
+    void ResetArena(const size_t arena) override;
+    ObjectAllocatorStats GetStats() const override;
+
+  private:
+    void* AllocateFromBlocks(detail::ObjectArena& arena, detail::ObjectPool& pool, const ObjectTypeInfo& type);
+
+    std::vector<detail::ObjectArena> _arenas;
+    detail::ObjectAllocationCounters _counters;
+  };
+
+  /**
+  Allocator using the global operator new and delete for every object, useful with external memory debugging tools.
+  */
+  class HeapObjectAllocator : public IObjectAllocator
+  {
+  public:
+    HeapObjectAllocator();
+
+    void* Allocate(const size_t arena, const ObjectTypeInfo& type) override;
+    void Deallocate(const size_t arena, const ObjectTypeInfo& type, void* memory) override;
+    void ResetArena(const size_t arena) override {}
+    ObjectAllocatorStats GetStats() const override;
+
+  private:
+    size_t _usedBytes;
+    detail::ObjectAllocationCounters _counters;
+  };
+}
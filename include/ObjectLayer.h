@@ -33,5 +33,10 @@ namespace JadeEngine
     Game objects in persistent scene are always rendered and updated.
     */
     kObjectLayer_Persistent_UI,
+
+    /**
+    Enumeration count for ObjectLayer. It has no logical meaning and it is not a valid layer for %game objects.
+    */
+    kObjectLayer_Count,
   };
 }
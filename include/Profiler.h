@@ -0,0 +1,122 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace JadeEngine
+{
+  /**
+  Phases of a single Game::Update tick that are measured by Profiler.
+  */
+  enum ProfilerPhase
+  {
+    kProfilerPhase_Destroy,
+    kProfilerPhase_Load,
+    kProfilerPhase_Hover,
+    kProfilerPhase_UpdateGameObjects,
+    kProfilerPhase_SceneUpdate,
+    kProfilerPhase_UpdateTransforms,
+    kProfilerPhase_Render,
+    kProfilerPhase_Present,
+    kProfilerPhase_Count
+  };
+
+  /**
+  How many past frames Profiler remembers.
+  */
+  const size_t kProfilerHistorySize = 256;
+
+  /**
+  Timings of a single frame, all in milliseconds.
+  */
+  struct ProfilerFrame
+  {
+    uint64_t                                  frameIndex;
+    float                                     frameTime;
+    std::array<float, kProfilerPhase_Count>   phaseTimes;
+  };
+
+  namespace detail
+  {
+    struct ProfilerFrameSlot
+    {
+      std::atomic<uint64_t>                                 frameIndex;
+      std::atomic<float>                                    frameTime;
+      std::array<std::atomic<float>, kProfilerPhase_Count>  phaseTimes;
+    };
+  }
+
+  /**
+  Collects timings of Game::Update phases into a ring buffer of last kProfilerHistorySize frames.
+
+  Writing is done only by the game loop, reading is lock-free and can be done from any thread.
+  A read of a frame that was overwritten while being read is detected and reported as failed.
+
+  @see GProfiler, ScopedProfilerPhase, Game::ShowProfilerOverlay
+  */
+  class Profiler
+  {
+  public:
+    Profiler();
+
+    void BeginFrame();
+    void EndFrame();
+    void AddPhaseTime(const ProfilerPhase phase, const float milliseconds);
+
+    /**
+    Read timings of a finished frame.
+
+    @param framesAgo 0 for the last finished frame, 1 for the one before it, etc.
+    @param frame Output frame timings.
+    @returns Whether the frame is still available in the history.
+    */
+    bool GetFrame(const size_t framesAgo, ProfilerFrame& frame) const;
+
+    /**
+    Average timings of last `frames` finished frames. Frames no longer in the history are ignored.
+    */
+    ProfilerFrame GetAverage(const size_t frames) const;
+
+    /**
+    Number of finished frames since the game started.
+    */
+    uint64_t GetFinishedFrames() const { return _finishedFrames.load(std::memory_order_acquire); }
+
+    static const char* GetPhaseName(const ProfilerPhase phase);
+
+  private:
+    std::array<detail::ProfilerFrameSlot, kProfilerHistorySize> _history;
+    std::atomic<uint64_t> _finishedFrames;
+
+    ProfilerFrame _currentFrame;
+    std::chrono::steady_clock::time_point _frameStart;
+  };
+
+  /**
+  Measures time from its construction to its destruction and adds it to a phase of the current frame.
+
+  @code
+  {
+    ScopedProfilerPhase phase(kProfilerPhase_Render);
+    RenderGameObjects(_currentScene);
+  }
+  @endcode
+  */
+  class ScopedProfilerPhase
+  {
+  public:
+    ScopedProfilerPhase(const ProfilerPhase phase);
+    ~ScopedProfilerPhase();
+
+    ScopedProfilerPhase(const ScopedProfilerPhase&) = delete;
+    ScopedProfilerPhase& operator=(const ScopedProfilerPhase&) = delete;
+
+  private:
+    ProfilerPhase _phase;
+    std::chrono::steady_clock::time_point _start;
+  };
+
+  extern Profiler GProfiler;
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "EngineDataTypes.h"
+
+#include <cstdint>
+#include <SDL.h>
+#include <vector>
+
+namespace JadeEngine
+{
+  class IGameObject;
+
+  namespace detail
+  {
+    enum RenderCacheState
+    {
+      kRenderCacheState_Dirty,
+      kRenderCacheState_Valid,
+      // The subtree contains objects in kRenderMode_Direct, it is rendered as usual until it changes
+      kRenderCacheState_Uncacheable,
+    };
+
+    /**
+    Texture holding a rendered subtree of %game objects.
+
+    @see Game::SetCachedAsTexture
+    */
+    struct RenderCache
+    {
+      RenderCacheState  state;
+      SDL_Texture*      texture;
+
+      // Area of the screen the texture covers, its top left corner is the texture's origin
+      Rectangle         bounds;
+
+      // Lowest of the subtree's objects in the rendering order, the texture is drawn in its place
+      IGameObject*      first;
+    };
+  }
+
+  /**
+  Render target textures kept for re-use by the caches of Game::SetCachedAsTexture.
+
+  Sizes are rounded up so a cache that grows or shrinks slightly, or another cache of similar size, can take over a released texture.
+  The textures hold premultiplied alpha and are drawn with a blend mode matching it where the renderer supports custom blend modes.
+
+  @see Game::SetCachedAsTexture
+  */
+  class RenderTargetPool
+  {
+  public:
+    RenderTargetPool();
+
+    RenderTargetPool(const RenderTargetPool&) = delete;
+    RenderTargetPool& operator=(const RenderTargetPool&) = delete;
+
+    /**
+    Get a released texture at least as large as requested or create a new one, nullptr when the renderer can not create it.
+    */
+    SDL_Texture* Acquire(SDL_Renderer* renderer, const uint32_t format, const int32_t width, const int32_t height);
+    void Release(SDL_Texture* texture);
+
+    /**
+    Destroy all textures, including those not released yet.
+    */
+    void Clear();
+
+  private:
+    std::vector<SDL_Texture*> _textures;
+    std::vector<SDL_Texture*> _released;
+    SDL_BlendMode _blendMode;
+  };
+}
@@ -0,0 +1,148 @@
+#pragma once
+
+#include "EngineDataTypes.h"
+
+#include <cstdint>
+#include <SDL.h>
+#include <utility>
+#include <vector>
+
+namespace JadeEngine
+{
+  /**
+  A single textured draw, the equivalent of one SDL_RenderCopy or SDL_RenderCopyEx call.
+
+  @see RenderCommandBuffer::Push
+  */
+  struct RenderCommand
+  {
+    SDL_Texture*    texture;
+    Rectangle       source;
+    Rectangle       destination;
+    double          angle;
+    bool            rotated;
+    SDL_Color       colorMod;
+    SDL_BlendMode   blendMode;
+    int32_t         z;
+    bool            clipped;
+    Rectangle       clip;
+  };
+
+  /**
+  Counters of a single frame of RenderCommandBuffer submissions.
+  */
+  struct RenderCommandStats
+  {
+    /**
+    Number of commands pushed into the buffer.
+    */
+    uint32_t commands;
+
+    /**
+    Number of SDL2 draw calls actually issued. Commands that are completely clipped, off-screen or transparent are not drawn.
+    */
+    uint32_t drawCalls;
+
+    /**
+    Number of times the drawn texture changed.
+    */
+    uint32_t textureSwitches;
+
+    /**
+    Number of times the drawn texture would have changed had the commands been drawn in the order they were pushed.
+    */
+    uint32_t unsortedTextureSwitches;
+
+    /**
+    Number of times the buffer was flushed, either by a %game object rendering directly or at the end of a frame.
+    */
+    uint32_t flushes;
+  };
+
+  namespace detail
+  {
+    struct RenderCommandBatch
+    {
+      SDL_Texture*          texture;
+      Rectangle             bounds;
+      std::vector<uint32_t> commands;
+    };
+  }
+
+  /**
+  Per-frame buffer of draw commands emitted by %game objects rendering in kRenderMode_Commands.
+
+  On flush the commands are grouped by texture to minimize texture and state switches.
+  A command is only ever moved before commands it does not overlap so the result is identical to drawing the commands in the order they were pushed.
+
+  @see Game::GetRenderCommands, IGameObject::SetRenderMode, RenderCommandStats
+  */
+  class RenderCommandBuffer
+  {
+  public:
+    RenderCommandBuffer();
+
+    RenderCommandBuffer(const RenderCommandBuffer&) = delete;
+    RenderCommandBuffer& operator=(const RenderCommandBuffer&) = delete;
+
+    /**
+    Push a command, its z is overwritten with the z of the %game object currently being rendered.
+    */
+    void Push(const RenderCommand& command);
+
+    /**
+    Helper for pushing the common case of a non-clipped draw with the texture's current blend mode.
+
+    @param source Part of the texture to draw or nullptr for the whole texture.
+    @param angle Rotation in degrees clockwise around the center of the destination.
+    */
+    void Push(SDL_Texture* texture, const Rectangle* source, const Rectangle& destination, const SDL_Color& colorMod, const double angle = 0.0);
+
+    /**
+    Set the clip rectangle of all commands pushed afterwards, nullptr to disable clipping. Commands with their own clip are limited by both.
+    */
+    void SetClip(const Rectangle* clip);
+
+    /**
+    Move the destination and own clip of all commands pushed afterwards, used to draw into a texture smaller than the screen.
+    The clip set by SetClip is not moved.
+    */
+    void SetOffset(const int32_t x, const int32_t y) { _offset = { x, y }; }
+
+    /**
+    Reorder and draw all pushed commands and empty the buffer.
+    */
+    void Flush(SDL_Renderer* renderer);
+
+    void BeginFrame(const int32_t targetWidth, const int32_t targetHeight);
+    void EndFrame(SDL_Renderer* renderer);
+    void SetCurrentZ(const int32_t z) { _currentZ = z; }
+
+    /**
+    Counters of the last finished frame.
+    */
+    const RenderCommandStats& GetLastFrameStats() const { return _lastFrameStats; }
+
+  private:
+    void Batch();
+    void Submit(SDL_Renderer* renderer);
+    void SetColorMod(SDL_Texture* texture, const SDL_Color& colorMod, const SDL_BlendMode blendMode);
+
+    std::vector<RenderCommand> _commands;
+    std::vector<Rectangle> _commandBounds;
+    std::vector<detail::RenderCommandBatch> _batches;
+    size_t _usedBatches;
+    std::vector<std::pair<SDL_Texture*, SDL_BlendMode>> _modifiedTextures;
+
+    Rectangle _target;
+    int32_t _currentZ;
+    bool _clipped;
+    Rectangle _clip;
+    SDL_Point _offset;
+
+    RenderCommandStats _frameStats;
+    RenderCommandStats _lastFrameStats;
+    SDL_Texture* _lastPushedTexture;
+    SDL_Texture* _lastDrawnTexture;
+  };
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "EngineDataTypes.h"
+
+#include <cstdint>
+#include <set>
+#include <vector>
+
+namespace JadeEngine
+{
+  class IGameObject;
+
+  namespace detail
+  {
+    struct RenderQueueEntry
+    {
+      int32_t       z;
+      uint64_t      order;
+      IGameObject*  gameObject;
+    };
+
+    struct RenderQueueEntryCompare
+    {
+      bool operator()(const RenderQueueEntry& a, const RenderQueueEntry& b) const
+      {
+        return a.z < b.z || (a.z == b.z && a.order < b.order);
+      }
+    };
+  }
+
+  /**
+  Ordered collection of %game objects of one scene in the order they should be rendered.
+
+  Game objects are ordered by their Z coordinate, ties are broken by the order of insertion so the ordering is stable.
+  Insertion, removal and re-keying after a Z change are all O(log n).
+
+  @see IGameObject::SetZ, Game::Create
+  */
+  class RenderQueue
+  {
+  public:
+    using Container = std::set<detail::RenderQueueEntry, detail::RenderQueueEntryCompare>;
+
+    RenderQueue();
+
+    RenderQueue(const RenderQueue&) = delete;
+    RenderQueue& operator=(const RenderQueue&) = delete;
+
+    void Insert(IGameObject* gameObject);
+    void Remove(IGameObject* gameObject);
+    void Clear();
+
+    Container::const_iterator begin() const { return _entries.cbegin(); }
+    Container::const_iterator end() const { return _entries.cend(); }
+    size_t Size() const { return _entries.size(); }
+
+    /**
+    Mark everything the queue renders as outdated.
+    */
+    void Invalidate() { _fullyInvalidated = true; }
+
+    /**
+    Whether changes are recorded for TakeInvalidated, off by default so a queue nobody takes changes from does not grow.
+    Turning it on marks everything as outdated as the changes made until then are unknown.
+    */
+    void SetChangeTracking(const bool tracking);
+
+    /**
+    Hand out what changed since the last call and reset it.
+
+    @param gameObjects Receives the %game objects which were inserted, re-keyed or invalidated via IGameObject::Invalidate.
+    @param areas Receives the last rendered bounds of the %game objects removed from the queue.
+    @return Whether everything was invalidated, in which case the two lists are incomplete.
+    */
+    bool TakeInvalidated(std::vector<IGameObject*>& gameObjects, std::vector<Rectangle>& areas);
+
+  private:
+    friend class IGameObject;
+    void Rekey(IGameObject* gameObject, const int32_t oldZ);
+    void Invalidate(IGameObject* gameObject);
+
+    Container _entries;
+    uint64_t _nextOrder;
+    bool _fullyInvalidated;
+    bool _tracking;
+    // Unordered, a removed object's slot is taken over by the last one
+    std::vector<IGameObject*> _invalidatedObjects;
+    std::vector<Rectangle> _exposedAreas;
+  };
+}
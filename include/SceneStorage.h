@@ -0,0 +1,65 @@
+#pragma once
+
+#include "IGameObject.h"
+#include "ObjectLayer.h"
+#include "RenderQueue.h"
+#include "SpatialGrid.h"
+#include "UpdateScheduler.h"
+
+#include <array>
+#include <memory>
+#include <vector>
+
+namespace JadeEngine::detail
+{
+  /**
+  Destructs a %game object and returns its memory to the IObjectAllocator it came from.
+  */
+  struct GameObjectDeleter
+  {
+    void operator()(IGameObject* gameObject) const;
+  };
+
+  using GameObjectPtr = std::unique_ptr<IGameObject, GameObjectDeleter>;
+
+  template<typename Class>
+  void UpdateGameObjectsOfClass(std::vector<IGameObject*>& gameObjects)
+  {
+    // Indexed as updating can create new objects of the same class
+    for (size_t i = 0; i < gameObjects.size(); i++)
+    {
+      const auto gameObject = static_cast<Class*>(gameObjects[i]);
+      if (gameObject != nullptr && gameObject->GetLoadState() == kLoadState_Done)
+      {
+        // Objects in the list were created as exactly Class so the call does not need to go through the virtual table
+        gameObject->Class::Update();
+      }
+    }
+  }
+
+  /**
+  %Game objects of a single scene together with the structures indexing them.
+
+  Destroyed objects leave an empty slot behind so the creation order, which is also the update order, is kept.
+  The slots are compacted once they make up half of the objects.
+  Memory of the objects comes from the arena of the same index in the IObjectAllocator.
+
+  @see IScene::GetStorageIndex, Game::Create
+  */
+  struct SceneStorage
+  {
+    std::vector<GameObjectPtr> gameObjects;
+
+    /**
+    ObjectCapability flags of `gameObjects`, 0 for empty slots. Kept separately so passes can skip objects without touching them.
+    */
+    std::vector<uint8_t> capabilities;
+
+    size_t emptySlots = 0;
+
+    UpdateScheduler updateScheduler;
+
+    RenderQueue renderQueue;
+    std::array<SpatialGrid, kObjectLayer_Count> spatialGrids;
+  };
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "EngineDataTypes.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace JadeEngine
+{
+  namespace detail
+  {
+    struct SkylineSegment
+    {
+      int32_t x;
+      int32_t y;
+      int32_t width;
+    };
+  }
+
+  /**
+  Packs rectangles into a fixed size area using the skyline bottom-left heuristic.
+
+  The packed area is described by its "skyline", the top edge of already placed rectangles. Every new rectangle is placed where its top would be lowest.
+
+  @see Game::Initialize, GameInitParams::packTextures
+  */
+  class SkylinePacker
+  {
+  public:
+    SkylinePacker(const int32_t width, const int32_t height);
+
+    /**
+    Find space for a rectangle.
+
+    @param result Output position and size of the placed rectangle.
+    @returns False if the rectangle no longer fits.
+    */
+    bool Insert(const int32_t width, const int32_t height, Rectangle& result);
+
+    int32_t GetWidth() const { return _width; }
+    int32_t GetHeight() const { return _height; }
+
+  private:
+    bool Fits(const size_t index, const int32_t width, const int32_t height, int32_t& y) const;
+    void AddSegment(const size_t index, const Rectangle& placed);
+
+    int32_t _width;
+    int32_t _height;
+    std::vector<detail::SkylineSegment> _skyline;
+  };
+}
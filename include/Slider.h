@@ -36,12 +36,17 @@ namespace JadeEngine
     Slider(const SliderParams& params);
 
     void Update() override;
+    void OnUIEvent(UIEvent& event) override;
 
     void Show(const bool shown) override;
 
     float GetValue() const { return _value; }
     bool Changed() const { return _valueChanged; }
-    bool Released() const { return _slidingReleased;  }
+
+    /**
+    Returns whether the pointer was let go this frame.
+    */
+    bool Released() const;
 
   private:
     Sprite* _pointer;
@@ -59,7 +64,7 @@ namespace JadeEngine
     float _value;
 
     bool _sliding;
-    bool _slidingReleased;
+    uint64_t _releasedFrame;
     int32_t _slidingOffset;
   };
 }
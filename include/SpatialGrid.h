@@ -0,0 +1,101 @@
+#pragma once
+
+#include "Vector2D.h"
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace JadeEngine
+{
+  class Sprite;
+
+  /**
+  Size in pixels of a single SpatialGrid cell.
+  */
+  const int32_t kSpatialGridCellSize = 64;
+
+  /**
+  Sprites covering more cells than this are not split into cells and are instead tested on every query.
+  */
+  const int32_t kSpatialGridMaxCellsPerSprite = 1024;
+
+  /**
+  Uniform grid of sprite testing boxes used to find hovered sprites without walking every %game object.
+
+  Cells are stored sparsely so the grid is unbounded and works for world coordinates as well.
+  Boxes are not tracked automatically, the owner is responsible for calling SpatialGrid::Move whenever sprite's testing box changes.
+
+  @see Game::Create, Transform::GetTestingBox
+  */
+  class SpatialGrid
+  {
+  public:
+    void Insert(Sprite* sprite, const Box_i32& box);
+    void Move(Sprite* sprite, const Box_i32& box);
+    void Remove(Sprite* sprite);
+    void Clear();
+
+    /**
+    Find the sprite with the highest Z whose cells contain the point and which passes the predicate.
+
+    Only sprites sharing the point's cell are passed to the predicate so it is expected to perform the exact test.
+    */
+    template<typename Predicate>
+    Sprite* FindTopmost(const int32_t x, const int32_t y, Predicate predicate) const
+    {
+      Sprite* result = nullptr;
+
+      const auto consider = [&](Sprite* sprite)
+      {
+        if ((result == nullptr || GetSpriteZ(sprite) > GetSpriteZ(result)) && predicate(sprite))
+        {
+          result = sprite;
+        }
+      };
+
+      const auto cell = _cells.find(CellKey(CellCoordinate(x), CellCoordinate(y)));
+      if (cell != std::end(_cells))
+      {
+        for (const auto sprite : cell->second)
+        {
+          consider(sprite);
+        }
+      }
+
+      for (const auto sprite : _oversized)
+      {
+        consider(sprite);
+      }
+
+      return result;
+    }
+
+  private:
+    struct CellRange
+    {
+      int32_t minX;
+      int32_t minY;
+      int32_t maxX;
+      int32_t maxY;
+
+      bool operator==(const CellRange& other) const
+      {
+        return minX == other.minX && minY == other.minY && maxX == other.maxX && maxY == other.maxY;
+      }
+    };
+
+    static int32_t GetSpriteZ(const Sprite* sprite);
+    static int32_t CellCoordinate(const int32_t coordinate);
+    static uint64_t CellKey(const int32_t cellX, const int32_t cellY);
+    static CellRange ToCellRange(const Box_i32& box);
+    static bool IsOversized(const CellRange& range);
+
+    void AddToCells(Sprite* sprite, const CellRange& range);
+    void RemoveFromCells(Sprite* sprite, const CellRange& range);
+
+    std::unordered_map<uint64_t, std::vector<Sprite*>> _cells;
+    std::unordered_map<Sprite*, CellRange> _ranges;
+    std::vector<Sprite*> _oversized;
+  };
+}
@@ -110,35 +110,34 @@ namespace JadeEngine
 
     void Render(SDL_Renderer* renderer) override;
     void Clean() override;
+    Rectangle GetRenderBounds() const override;
 
     /**
     Tint the sprite with a single color.
 
-    @warning The first time Sprite is tinted or its transparency changed `MakeTextureUnique` is called which is potentially expensive operation. Consider calling `MakeTextureUnique` explicitly during initialization to avoid flickering.
-    @warning Sprite-sheet Sprites are not recommended to be used with SetAlpha.
+    The tint is applied when the sprite is rendered, the texture shared with other Sprites is not modified.
+
     @param tintColor RGBA 0-255 color that will be used to multiply each pixel of the sprite. Alpha component is ignored.
-    @see Sprite::MakeTextureUnique
     */
     void Tint(const SDL_Color& tintColor);
 
     /**
     Changed the transparency of the sprite.
 
-    @warning The first time Sprite is tinted or its transparency changed `MakeTextureUnique` is called which is potentially expensive operation. Consider calling `MakeTextureUnique` explicitly during initialization to avoid flickering.
-    @warning Sprite-sheet Sprites are not recommended to be used with SetAlpha.
+    The transparency is applied when the sprite is rendered, the texture shared with other Sprites is not modified.
+
     @param alpha Transparency alpha value to set. 0 will make the sprite completely invisible, 1 fully opaque. It will be clamped to [0.0f, 1.0f] range.
-    @see Sprite::MakeTextureUnique
     */
     void SetAlpha(const float alpha);
 
     /**
     Create a deep-copy of the Sprite texture that is not shared with other Sprites using the same texture.
 
-    This operation is necessary for `Sprite::Tint` and `Sprite::SetAlpha` and will be called automatically on their first call unless already called by the user.
+    Neither `Sprite::Tint` nor `Sprite::SetAlpha` need a unique texture, this is only useful when the texture itself is going to be modified.
 
     @warning This is potentially expensive operation as it deep-copying the texture using `Game::CopyTexture`.
 
-    @see Sprite::Tint, Sprite::SetAlpha, Game::CopyTexture
+    @see Game::CopyTexture
     */
     void MakeTextureUnique();
 
@@ -215,6 +214,11 @@ namespace JadeEngine
     */
     const std::string& GetTextureName() const;
 
+    /**
+    Return the layer the sprite was created in.
+    */
+    ObjectLayer GetLayer() const { return _layer; }
+
   protected:
     std::shared_ptr<Texture> _textureDescription;
     const detail::SpriteSheetDescription* _spriteSheetDescription;
@@ -228,6 +232,7 @@ namespace JadeEngine
     bool _rotated;
 
     float _alpha;
+    SDL_Color _colorMod;
     double _rotationAngle;
 
     ObjectLayer _layer;
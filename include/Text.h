@@ -1,6 +1,7 @@
 #pragma once
 
 #include "EngineDataTypes.h"
+#include "GlyphAtlas.h"
 #include "IGameObject.h"
 #include "ObjectLayer.h"
 
@@ -33,8 +34,6 @@ namespace JadeEngine
     void SetColorFast(const SDL_Color& color);
     void SetMask(const Rectangle& mask);
 
-    void Clean() override;
-
     const SDL_Color& GetColor() const { return _color; }
     TTF_Font* GetFont() const { return _font; }
     const std::string& GetText() const { return _text; }
@@ -42,13 +41,13 @@ namespace JadeEngine
     std::string _text;
 
   private:
-    void RemoveCache();
+    void Relayout();
 
     bool _masked;
     Rectangle _mask;
 
     TTF_Font* _font;
-    SDL_Texture* _cachedTexture;
+    TextLayout _layout;
     SDL_Color _color;
   };
 }
\ No newline at end of file
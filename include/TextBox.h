@@ -1,5 +1,6 @@
 #pragma once
 
+#include "GlyphAtlas.h"
 #include "IGameObject.h"
 #include "ObjectLayer.h"
 
@@ -27,8 +28,7 @@ namespace JadeEngine
 
     LoadState Load(SDL_Renderer* renderer) override;
     void Render(SDL_Renderer* renderer) override;
-
-    void Clean() override;
+    Rectangle GetRenderBounds() const override;
 
     void SetText(const std::string& text);
 
@@ -45,7 +45,7 @@ namespace JadeEngine
     int32_t GetHeight() const;
 
   private:
-    void RemoveCache();
+    void Relayout();
 
     TTF_Font* _font;
     SDL_Color _color;
@@ -56,7 +56,8 @@ namespace JadeEngine
     int32_t _y;
     int32_t _width;
     int32_t _height;
+    int32_t _wrapWidth;
 
-    SDL_Texture* _cachedTexture;
+    TextLayout _layout;
   };
 }
@@ -1,24 +1,27 @@
 #pragma once
 
+#include "HitMask.h"
 #include "TextureSampling.h"
 
-#include <vector>
+#include <memory>
 #include <SDL.h>
 
 namespace JadeEngine
 {
   struct Texture
   {
-    Texture(SDL_Texture* itexture, int32_t iwidth, int32_t iheight, const Rectangle& iboundingBox, const std::vector<bool>& ihitArray, const std::string& iname, uint32_t iformat, bool iisCopy, const TextureSampling isampling)
+    Texture(SDL_Texture* itexture, int32_t iwidth, int32_t iheight, const Rectangle& iboundingBox, const std::shared_ptr<const HitMask>& ihitMask, const std::string& iname, uint32_t iformat, bool iisCopy, const TextureSampling isampling)
       : texture(itexture)
       , width(iwidth)
       , height(iheight)
       , boundingBox(iboundingBox)
-      , hitArray(ihitArray)
+      , hitMask(ihitMask)
       , name(iname)
       , format(iformat)
       , isCopy(iisCopy)
       , sampling(isampling)
+      , source{ 0, 0, iwidth, iheight }
+      , packed(false)
     {}
 
     Texture(const Texture& other)
@@ -26,22 +29,41 @@ namespace JadeEngine
       , width(other.width)
       , height(other.height)
       , boundingBox(other.boundingBox)
-      , hitArray(other.hitArray)
+      , hitMask(other.hitMask)
       , name(other.name)
       , format(other.format)
       , isCopy(other.isCopy)
       , sampling(other.sampling)
+      , source(other.source)
+      , packed(other.packed)
     {}
 
     SDL_Texture* texture;
     int32_t width;
     int32_t height;
     Rectangle boundingBox;
-    std::vector<bool> hitArray;
+
+    /**
+    Opacity of the texture's pixels, nullptr unless the texture was loaded with a hit map. Shared with all copies of the texture.
+    @see GameInitParamsTextureEntry::generateHitMap
+    */
+    std::shared_ptr<const HitMask> hitMask;
+
     std::string name;
     uint32_t format;
     bool isCopy;
     TextureSampling sampling;
+
+    /**
+    Part of `texture` holding the image. The whole texture unless the image was packed into a shared atlas page.
+    @see GameInitParams::packTextures
+    */
+    Rectangle source;
+
+    /**
+    Whether `texture` is a shared atlas page owned by Game rather than a texture of this image only.
+    */
+    bool packed;
   };
 }
 
@@ -1,158 +1,36 @@
 ﻿#pragma once
 
+#include "TransformSystem.h"
 #include "Vector2D.h"
 
+#include <cassert>
 #include <cstdint>
-#include <memory>
-#include <vector>
-#include <bitset>
 
 namespace JadeEngine
 {
-  class Transform;
-
-  /**
-  Specifies type of transform's properties that were changed - dirtied - last frame.
-
-  @see Transform::IsDirty
-  */
-  enum DirtyFlag
-  {
-    /**
-    Flag for the transform's position - `Transform::GetPosition`.
-    */
-    kDirtyFlag_Position,
-
-    /**
-    Flag for the transform's center position - `Transform::GetCenterPosition`.
-    */
-    kDirtyFlag_CenterPosition,
-
-    /**
-    Flag for the transform's position - `Transform::GetSize`.
-    */
-    kDirtyFlag_Size,
-
-    /**
-    Flag for the transform's position - `Transform::GetBoundingBox`.
-    */
-    kDirtyFlag_BoundingBox,
-
-    /**
-    Enumeration count for DirtyFlag. It has no logical meaning and it is not a valid flag for Transform functions.
-    */
-    kDirtyFlag_Count
-  };
-
-  /**
-  Anchor specifies a point within an object's bounding box.
-
-  In the process of attaching one transform to another one can specify parent and child anchors for convenient positioning.
-  */
-  enum Anchor
-  {
-    /**
-    Left-top corner of the bounding box.
-
-    *═══╗
-    ║   ║
-    ╚═══╝
-    */
-    kAnchor_LeftTop,
-
-    /**
-    Center-top of the bounding box.
-    ╔═*═╗
-    ║   ║
-    ╚═══╝
-    */
-    kAnchor_CenterTop,
-
-    /**
-    Right-top corner of the bounding box.
-    ╔═══*
-    ║   ║
-    ╚═══╝
-    */
-    kAnchor_RightTop,
-
-    /**
-    Right-center of the bounding box.
-    ╔═══╗
-    ║   *
-    ╚═══╝
-    */
-    kAnchor_RightCenter,
-
-    /**
-    Right-bottom corner of the bounding box.
-    ╔═══╗
-    ║   ║
-    ╚═══*
-    */
-    kAnchor_RightBottom,
-
-    /**
-    Center-bottom of the bounding box.
-    ╔═══╗
-    ║   ║
-    ╚═*═╝
-    */
-    kAnchor_CenterBottom,
-
-    /**
-    Left-bottom corner of the bounding box.
-    ╔═══╗
-    ║   ║
-    *═══╝
-    */
-    kAnchor_LeftBottom,
-
-    /**
-    Left-center of the bounding box.
-    ╔═══╗
-    *   ║
-    ╚═══╝
-    */
-    kAnchor_LeftCenter,
-
-    /**
-    Center of the bounding box.
-    ╔═══╗
-    ║ * ║
-    ╚═══╝
-    */
-    kAnchor_Center,
-  };
-
-  const Anchor kDefaultAnchor = kAnchor_LeftTop;
-
-  namespace detail
-  {
-    struct TransformAttachmentData
-    {
-      Vector2D_i32 localPosition;
-      Anchor parentAnchor;
-      Anchor childAnchor;
-    };
-  }
-
-  using detail::TransformAttachmentData;
-
   /**
   Transform is a %game object's property that specify their position and size in a coordinate system.
 
   The transform itself does not have concept of the coordinate system, that is entirely driven by the owning %game object. The coordinate system will usually be either world or screen coordinate system.
+
+  Transform is a lightweight handle, its data lives in GTransformSystem. Copies of the handle refer to the same transform and all functions, including the setters, are const as they do not change the handle itself.
+  The `->` operator is provided so the handle can be used the same way as a pointer, i.e. `gameObject->transform->GetX()`.
+
+  @see TransformSystem
   */
-  class Transform : public std::enable_shared_from_this<Transform>
+  class Transform
   {
   public:
     /**
-    Default constructor for transform that initializes the position and size to 0s.
+    Default constructor creating an invalid handle that does not refer to any transform.
 
-    The bounding box will have position and size 0,0. The transform will have no parent.
+    Use TransformSystem::Create to create a new transform with position and size 0s and no parent.
     */
-    Transform();
+    Transform()
+      : _slot(kInvalidTransformSlot)
+      , _generation(0)
+    {
+    }
 
     /**
     Initializes the transform with position and size vectors.
@@ -168,81 +46,81 @@ namespace JadeEngine
     }
     @endcode
     */
-    void Initialize(const Vector2D_i32& position, const Vector2D_i32& size);
+    void Initialize(const Vector2D_i32& position, const Vector2D_i32& size) const;
 
     /**
     Initializes the transform with position and size vector elements. See the vector version for more information.
     */
-    void Initialize(const int32_t x, const int32_t y, const int32_t w, const int32_t h);
+    void Initialize(const int32_t x, const int32_t y, const int32_t w, const int32_t h) const;
 
     /**
     Returns the x coordinate of the top-left corner of the transform.
 
     Same as `GetPosition().x`.
     */
-    int32_t GetX() const { return _position.x; }
+    int32_t GetX() const { return GTransformSystem._positions[ResolvedSlot()].x; }
 
     /**
     Returns the y coordinate of the top-left corner of the transform.
 
     Same as `GetPosition().y`.
     */
-    int32_t GetY() const { return _position.y; }
+    int32_t GetY() const { return GTransformSystem._positions[ResolvedSlot()].y; }
 
     /**
     Returns the width of the transform.
 
     Same as `GetSize().w`.
     */
-    int32_t GetWidth() const { return _size.w; }
+    int32_t GetWidth() const { return GTransformSystem._sizes[Slot()].w; }
 
     /**
     Returns the height of transform.
 
     Same as `GetSize().h`.
     */
-    int32_t GetHeight() const { return _size.h; }
+    int32_t GetHeight() const { return GTransformSystem._sizes[Slot()].h; }
 
     /**
     Returns the x coordinate of the center of the transform.
 
     Same as `GetCenterPosition().x`.
     */
-    int32_t GetCenterX() const { return _centerPosition.x; }
+    int32_t GetCenterX() const { return GTransformSystem._centerPositions[ResolvedSlot()].x; }
 
     /**
     Returns the y coordinate of the center of the transform.
 
     Same as `GetCenterPosition().y`.
     */
-    int32_t GetCenterY() const { return _centerPosition.y; }
+    int32_t GetCenterY() const { return GTransformSystem._centerPositions[ResolvedSlot()].y; }
 
     /**
     Returns the x and y coordinates of the top-left corner of the transform as a vector.
     */
-    Vector2D_i32 GetPosition() const { return _position; }
+    Vector2D_i32 GetPosition() const { return GTransformSystem._positions[ResolvedSlot()]; }
 
     /**
     Returns the x and y coordinates of the center of the transform as a vector.
     */
-    Vector2D_i32 GetCenterPosition() const { return _centerPosition; }
+    Vector2D_i32 GetCenterPosition() const { return GTransformSystem._centerPositions[ResolvedSlot()]; }
 
     /**
     Returns the width and height of the transform as a vector.
     */
-    Vector2D_i32 GetSize() const { return _size; }
+    Vector2D_i32 GetSize() const { return GTransformSystem._sizes[Slot()]; }
 
     /**
     Returns the transform representation as Box.
     */
-    Box_i32 GetBox() const { return _transformationBox; }
+    Box_i32 GetBox() const { const auto slot = ResolvedSlot(); return { GTransformSystem._positions[slot], GTransformSystem._sizes[slot] }; }
 
     /**
     Returns the transform's bounding box.
 
     A bounding box that represents non-empty content of the transform box and its position is relative to the transform x,y.
     */
-    Box_i32 GetBoundingBox() const { return _boundingBox; }
+    Box_i32 GetBoundingBox() const { return GTransformSystem._boundingBoxes[Slot()]; }
 
     /**
     Returns the transform's testing box.
@@ -256,6 +134,13 @@ namespace JadeEngine
     */
     bool IsAttached() const;
 
+    /**
+    Returns the transform this transform is attached to or an invalid handle if it is not attached.
+
+    @see Transform::IsAttached, Transform::IsValid
+    */
+    Transform GetParent() const;
+
     /**
     Returns local position of the transform. This value only has effect when `IsAttached()` is true.
 
@@ -263,7 +148,7 @@ namespace JadeEngine
 
     @see Transform::Attach, Transform::IsAttached, Anchor
     */
-    Vector2D_i32 GetLocalPosition() const { return _attachmentData.localPosition; }
+    Vector2D_i32 GetLocalPosition() const { return GTransformSystem._attachments[Slot()].localPosition; }
 
     /**
     Set the transform x and y position as a vector in pixels.
@@ -273,12 +158,12 @@ namespace JadeEngine
 
     @see Transform::Attach, Transform::SetCenterPosition, Transform::GetPosition
     */
-    void SetPosition(const Vector2D_i32& position);
+    void SetPosition(const Vector2D_i32& position) const;
 
     /**
     Set the transform x and y position as vector's element in pixels. See the vector version for more information.
     */
-    void SetPosition(const int32_t x, const int32_t y);
+    void SetPosition(const int32_t x, const int32_t y) const;
 
     /**
     Set the transform's center x and y position as a vector in pixels.
@@ -288,12 +173,12 @@ namespace JadeEngine
 
     @see Transform::Attach, Transform::SetPosition, Transform::GetCenterPosition
     */
-    void SetCenterPosition(const Vector2D_i32& centerPosition);
+    void SetCenterPosition(const Vector2D_i32& centerPosition) const;
 
     /**
     Set the transform's center x and y position as a vector's element in pixels. See the vector version for more information.
     */
-    void SetCenterPosition(const int32_t centerX, const int32_t centerY);
+    void SetCenterPosition(const int32_t centerX, const int32_t centerY) const;
 
     /**
     Set transforms x and y position so that the passed anchor point will be positioned exactly at the passed position as vector in pixels.
@@ -304,26 +189,26 @@ namespace JadeEngine
 
     @see Anchor, Transform::SetPosition, Transform::SetCenterPosition
     */
-    void SetPositionAnchor(const Vector2D_i32& position, const Anchor& point);
+    void SetPositionAnchor(const Vector2D_i32& position, const Anchor& point) const;
 
     /**
     Set transforms x and y position so that the passed anchor point will be positioned exactly at the passed position as vector's elements in pixels. See the vector version for more information.
     */
-    void SetPositionAnchor(const int32_t x, const int32_t y, const Anchor& point);
+    void SetPositionAnchor(const int32_t x, const int32_t y, const Anchor& point) const;
 
     /**
     Set the height of the transform in pixels. Internally calls Transform::SetSize, see that for more information.
 
     @see Transform::SetSize
     */
-    void SetHeight(const int32_t height);
+    void SetHeight(const int32_t height) const;
 
     /**
     Set the width of the transform in pixels. Internally calls Transform::SetSize, see that for more information.
 
     @see Transform::SetSize
     */
-    void SetWidth(const int32_t width);
+    void SetWidth(const int32_t width) const;
 
     /**
     Set the width and height of the transform in pixels.
@@ -334,12 +219,12 @@ namespace JadeEngine
 
     @see Transform::SetBoundingBox
     */
-    void SetSize(const Vector2D_i32& size);
+    void SetSize(const Vector2D_i32& size) const;
 
     /**
     Set the width and height of the transform in pixels. See the vector version for more information.
     */
-    void SetSize(const int32_t width, const int32_t height);
+    void SetSize(const int32_t width, const int32_t height) const;
 
     /**
     Set the bounding box of the transform.
@@ -350,7 +235,7 @@ namespace JadeEngine
 
     @see Transform::GetBoundingBox, Transform::SetSize
     */
-    void SetBoundingBox(const Box_i32& box);
+    void SetBoundingBox(const Box_i32& box) const;
 
     /**
     Set the transform's x and y of the local position in pixels.
@@ -360,12 +245,12 @@ namespace JadeEngine
     @pre The transform must have been previously attached to another transform via Transform::Attach. You can check whether transform is attached via Transform::IsAttached.
     @see Transform::Attach, Transform::IsAttached, Anchor
     */
-    void SetLocalPosition(const Vector2D_i32& position);
+    void SetLocalPosition(const Vector2D_i32& position) const;
 
     /**
     Set the transform's x and y of the local position in pixels. See the vector version for more information.
     */
-    void SetLocalPosition(const int32_t x, const int32_t y);
+    void SetLocalPosition(const int32_t x, const int32_t y) const;
 
     /**
     Attach `other` transform to `this` transform, making the `other` transform a child of `this` - parent - transform.
@@ -381,7 +266,7 @@ namespace JadeEngine
 
     @see Transform::SetLocalPosition, Transform::GetLocalPosition, Transform::IsAttached, Anchor
     */
-    void Attach(const std::shared_ptr<Transform>& other, const Vector2D_i32& localPosition = kZeroVector2D_i32, const Anchor& anchor = kDefaultAnchor, const Anchor& otherAnchor = kDefaultAnchor);
+    void Attach(const Transform& other, const Vector2D_i32& localPosition = kZeroVector2D_i32, const Anchor& anchor = kDefaultAnchor, const Anchor& otherAnchor = kDefaultAnchor) const;
 
     /**
     Detach the transform from its the parent.
@@ -391,14 +276,7 @@ namespace JadeEngine
     @pre The transform must have been previously attached to another transform via Transform::Attach. You can check whether transform is attached via Transform::IsAttached.
     @see Transform::IsAttached, Transform::Attach
     */
-    void Detach();
-
-    /**
-    Update the transform's dirty flags.
-
-    @warning Used internally by the Jade Engine and there is very little reason to call this as a user.
-    */
-    void Update();
+    void Detach() const;
 
     /**
     Returns whether a property of transform has changed the previous frame.
@@ -411,26 +289,54 @@ namespace JadeEngine
     */
     bool IsDirty(const DirtyFlag flag) const;
 
+    /**
+    Returns whether the handle refers to a transform that was not destroyed.
+    */
+    bool IsValid() const { return GTransformSystem.IsAlive(*this); }
+
+    /**
+    Index of the transform's slot in TransformSystem. It is unique among valid transforms but reused once the transform is destroyed.
+    */
+    uint32_t GetIndex() const { return _slot; }
+
+    const Transform* operator->() const { return this; }
+
+    bool operator==(const Transform& other) const { return _slot == other._slot && _generation == other._generation; }
+    bool operator!=(const Transform& other) const { return !(*this == other); }
+
   private:
-    void OnAttached(const std::shared_ptr<Transform>& parent, const detail::TransformAttachmentData& data);
-    void OnAttachedPositionChange();
-    void OnChildDetached(const std::shared_ptr<Transform>& child);
+    friend class TransformSystem;
 
-    Vector2D_i32 _centerPosition;
-    Vector2D_i32 _position;
-    Vector2D_i32 _size;
+    Transform(const uint32_t slot, const uint32_t generation)
+      : _slot(slot)
+      , _generation(generation)
+    {
+    }
 
-    TransformAttachmentData _attachmentData;
+    uint32_t Slot() const
+    {
+      assert(IsValid());
+      return _slot;
+    }
 
-    bool _boundingBoxSet;
-    Box_i32 _boundingBox;
-    Box_i32 _transformationBox;
+    // Slot whose position is up to date with its ancestors
+    uint32_t ResolvedSlot() const
+    {
+      const auto slot = Slot();
+      if (GTransformSystem._pendingPropagationCount != 0)
+      {
+        GTransformSystem.ResolveAncestors(slot);
+      }
+      return slot;
+    }
 
-    std::bitset<kDirtyFlag_Count> _dirtyFlagsCurrentFrame;
-    std::bitset<kDirtyFlag_Count> _dirtyFlags;
+    static void OnAttachedPositionChange(const uint32_t slot);
+    static void SetPosition(const uint32_t slot, const Vector2D_i32& position);
+    static void SetCenterPosition(const uint32_t slot, const Vector2D_i32& centerPosition);
+    static void MoveChildren(const uint32_t slot);
 
-    std::shared_ptr<Transform> _parent;
-    std::vector<std::shared_ptr<Transform>> _children;
+    uint32_t _slot;
+    uint32_t _generation;
   };
 
 }
\ No newline at end of file
@@ -45,8 +45,8 @@ namespace JadeEngine
     int32_t GetElementSpacing(const size_t index);
 
   private:
-    void Add(const std::shared_ptr<Transform>& elementTransform);
-    void Add(const std::shared_ptr<Transform>& elementTransform, const int32_t spacing);
+    void Add(const Transform& elementTransform);
+    void Add(const Transform& elementTransform, const int32_t spacing);
     void Align();
 
     static Anchor ParentAnchor(const GroupDirection direction, const int32_t alignment);
@@ -54,7 +54,7 @@ namespace JadeEngine
 
     int32_t _alignment;
     GroupDirection _direction;
-    std::vector<std::shared_ptr<Transform>> _elements;
+    std::vector<Transform> _elements;
     std::vector<int32_t> _spacing;
     int32_t _defaultSpacing;
     Anchor _parentAnchor;
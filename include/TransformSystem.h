@@ -0,0 +1,261 @@
+#pragma once
+
+#include "Vector2D.h"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace JadeEngine
+{
+  class Transform;
+
+  /**
+  Specifies type of transform's properties that were changed - dirtied - last frame.
+
+  @see Transform::IsDirty
+  */
+  enum DirtyFlag
+  {
+    /**
+    Flag for the transform's position - `Transform::GetPosition`.
+    */
+    kDirtyFlag_Position,
+
+    /**
+    Flag for the transform's center position - `Transform::GetCenterPosition`.
+    */
+    kDirtyFlag_CenterPosition,
+
+    /**
+    Flag for the transform's position - `Transform::GetSize`.
+    */
+    kDirtyFlag_Size,
+
+    /**
+    Flag for the transform's position - `Transform::GetBoundingBox`.
+    */
+    kDirtyFlag_BoundingBox,
+
+    /**
+    Enumeration count for DirtyFlag. It has no logical meaning and it is not a valid flag for Transform functions.
+    */
+    kDirtyFlag_Count
+  };
+
+  /**
+  Anchor specifies a point within an object's bounding box.
+
+  In the process of attaching one transform to another one can specify parent and child anchors for convenient positioning.
+  */
+  enum Anchor
+  {
+    /**
+    Left-top corner of the bounding box.
+
+    *═══╗
+    ║   ║
+    ╚═══╝
+    */
+    kAnchor_LeftTop,
+
+    /**
+    Center-top of the bounding box.
+    ╔═*═╗
+    ║   ║
+    ╚═══╝
+    */
+    kAnchor_CenterTop,
+
+    /**
+    Right-top corner of the bounding box.
+    ╔═══*
+    ║   ║
+    ╚═══╝
+    */
+    kAnchor_RightTop,
+
+    /**
+    Right-center of the bounding box.
+    ╔═══╗
+    ║   *
+    ╚═══╝
+    */
+    kAnchor_RightCenter,
+
+    /**
+    Right-bottom corner of the bounding box.
+    ╔═══╗
+    ║   ║
+    ╚═══*
+    */
+    kAnchor_RightBottom,
+
+    /**
+    Center-bottom of the bounding box.
+    ╔═══╗
+    ║   ║
+    ╚═*═╝
+    */
+    kAnchor_CenterBottom,
+
+    /**
+    Left-bottom corner of the bounding box.
+    ╔═══╗
+    ║   ║
+    *═══╝
+    */
+    kAnchor_LeftBottom,
+
+    /**
+    Left-center of the bounding box.
+    ╔═══╗
+    *   ║
+    ╚═══╝
+    */
+    kAnchor_LeftCenter,
+
+    /**
+    Center of the bounding box.
+    ╔═══╗
+    ║ * ║
+    ╚═══╝
+    */
+    kAnchor_Center,
+  };
+
+  const Anchor kDefaultAnchor = kAnchor_LeftTop;
+
+  namespace detail
+  {
+    struct TransformAttachmentData
+    {
+      Vector2D_i32 localPosition;
+      Anchor parentAnchor;
+      Anchor childAnchor;
+    };
+
+    const uint32_t kInvalidTransformSlot = UINT32_MAX;
+  }
+
+  using detail::TransformAttachmentData;
+  using detail::kInvalidTransformSlot;
+
+  /**
+  Storage of all transforms, kept as structure of arrays indexed by the transform handles.
+
+  Every property has its own contiguous array indexed by the slot.
+  Parent and children are linked through indices, children of a transform form a doubly linked list in the order they were attached.
+
+  Slots of destroyed transforms are reused, each slot has a generation which invalidates handles to the previous occupant.
+
+  Dirty flags are not reset every frame. Each transform remembers the frame in which each of its properties last changed and Update only advances the frame counter,
+  transforms changed during a frame are collected in a list so the engine only visits those.
+
+  By default moving or resizing a transform immediately moves all its attached descendants. With deferred propagation the descendants are only marked and moved once per frame by Propagate, top-down.
+  Reading a position of a transform whose ancestor has a pending change resolves that ancestor's subtree first so the values are always consistent.
+
+  @see Transform, IGameObject::transform
+  */
+  class TransformSystem
+  {
+  public:
+    TransformSystem();
+
+    TransformSystem(const TransformSystem&) = delete;
+    TransformSystem& operator=(const TransformSystem&) = delete;
+
+    /**
+    Create a new transform with position and size 0s and no parent.
+    */
+    Transform Create();
+
+    /**
+    Release the transform's slot. The transform is detached from its parent and its children are detached from it, keeping their position.
+    */
+    void Destroy(const Transform& transform);
+
+    /**
+    Whether the handle points to a transform that was not destroyed yet.
+    */
+    bool IsAlive(const Transform& transform) const;
+
+    /**
+    Make changes of all transforms done since the last call visible through Transform::IsDirty and GetDirtyTransforms, hiding the ones done before it.
+
+    @warning Used internally by the Jade Engine and there is very little reason to call this as a user.
+    */
+    void Update();
+
+    /**
+    Transforms changed between the last two calls of Update, i.e. the ones which can have a dirty flag set.
+
+    A transform destroyed in the meantime stays in the list, check Transform::IsValid.
+    */
+    const std::vector<Transform>& GetDirtyTransforms() const { return _dirtyTransforms; }
+
+    /**
+    Move attached descendants of changed transforms, each at most once. Does nothing unless propagation is deferred.
+
+    @warning Used internally by the Jade Engine and there is very little reason to call this as a user.
+    */
+    void Propagate();
+
+    /**
+    Switch between moving attached descendants immediately when a transform changes and moving them in Propagate.
+
+    @see GameInitParams::deferTransformPropagation
+    */
+    void SetDeferredPropagation(const bool deferred);
+
+    bool GetDeferredPropagation() const { return _deferredPropagation; }
+
+    /**
+    Number of transforms that were not destroyed.
+    */
+    size_t GetCount() const { return _generations.size() - _freeSlots.size(); }
+
+  private:
+    friend class Transform;
+
+    void Link(const uint32_t parent, const uint32_t child);
+    void Unlink(const uint32_t child);
+    void MarkPropagationPending(const uint32_t slot);
+    void ResolveAncestors(const uint32_t slot);
+    void ResolveChildren(const uint32_t slot);
+    void MarkDirty(const uint32_t slot, const uint8_t flags);
+    bool IsDirty(const uint32_t slot, const DirtyFlag flag) const;
+
+    std::vector<Vector2D_i32> _positions;
+    std::vector<Vector2D_i32> _centerPositions;
+    std::vector<Vector2D_i32> _sizes;
+    std::vector<Box_i32> _boundingBoxes;
+    std::vector<uint8_t> _boundingBoxesSet;
+
+    // Frame of the last and of the one before last change of each DirtyFlag, a flag is dirty if it changed in the previous frame
+    std::vector<std::array<uint32_t, kDirtyFlag_Count>> _changeFrames;
+    std::vector<std::array<uint32_t, kDirtyFlag_Count>> _previousChangeFrames;
+    std::vector<uint32_t> _lastChangeFrames;
+
+    uint32_t _frame;
+    std::vector<Transform> _changedTransforms;
+    std::vector<Transform> _dirtyTransforms;
+
+    std::vector<TransformAttachmentData> _attachments;
+    std::vector<uint32_t> _parents;
+    std::vector<uint32_t> _firstChildren;
+    std::vector<uint32_t> _lastChildren;
+    std::vector<uint32_t> _nextSiblings;
+    std::vector<uint32_t> _previousSiblings;
+
+    std::vector<uint32_t> _generations;
+    std::vector<uint32_t> _freeSlots;
+
+    bool _deferredPropagation;
+    size_t _pendingPropagationCount;
+    std::vector<uint8_t> _propagationPending;
+    std::vector<uint32_t> _pendingPropagations;
+  };
+
+  extern TransformSystem GTransformSystem;
+}
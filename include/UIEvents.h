@@ -0,0 +1,152 @@
+#pragma once
+
+#include "Transform.h"
+
+#include <cstdint>
+#include <SDL.h>
+#include <utility>
+#include <vector>
+
+namespace JadeEngine
+{
+  class IGameObject;
+  class Sprite;
+
+  /**
+  Kind of UIEvent.
+
+  @see UIEvent, IGameObject::OnUIEvent
+  */
+  enum UIEventType
+  {
+    /**
+    Mouse started hovering the %game object or one of its children. Only delivered to the %game object itself.
+    */
+    kUIEventType_Enter,
+
+    /**
+    Mouse no longer hovers the %game object nor any of its children. Only delivered to the %game object itself.
+    */
+    kUIEventType_Leave,
+
+    /**
+    Mouse button, stored in UIEvent::mouseButton, was pressed this frame.
+    */
+    kUIEventType_Press,
+
+    /**
+    Mouse button, stored in UIEvent::mouseButton, was released this frame.
+    */
+    kUIEventType_Release,
+
+    /**
+    Mouse wheel moved this frame, the amount is stored in UIEvent::wheelY.
+    */
+    kUIEventType_Wheel,
+
+    /**
+    Key, stored in UIEvent::key, was pressed this frame.
+    */
+    kUIEventType_Key,
+  };
+
+  /**
+  Stage of the event's travel through the transform hierarchy.
+
+  Press, Release, Wheel and Key events first travel from the topmost ancestor down to the target (capture),
+  are delivered to the target and then travel back up to the topmost ancestor (bubble).
+
+  @see UIEvent::phase
+  */
+  enum UIEventPhase
+  {
+    kUIEventPhase_Capture,
+    kUIEventPhase_Target,
+    kUIEventPhase_Bubble,
+  };
+
+  /**
+  Input event delivered to the %game objects it concerns via IGameObject::OnUIEvent.
+
+  @see UIEventRouter, IGameObject::OnUIEvent
+  */
+  struct UIEvent
+  {
+    UIEventType   type;
+    UIEventPhase  phase;
+
+    /**
+    The %game object the event is aimed at. Either the hovered sprite or the %game object that captured the mouse.
+
+    @see Game::CaptureMouse
+    */
+    IGameObject*  target;
+
+    /**
+    Sprite under the mouse cursor, can differ from `target` while the mouse is captured.
+    */
+    Sprite*       hoveredSprite;
+
+    int32_t       mouseButton;
+    int32_t       wheelY;
+    SDL_Keycode   key;
+
+    /**
+    Number of the frame the event was dispatched in, compare with Game::GetUIEventFrame to tell whether it happened this frame.
+    */
+    uint64_t      frame;
+
+    /**
+    Set by a receiver to stop the event from travelling any further.
+    */
+    bool          handled;
+  };
+
+  /**
+  Turns the hovered sprite and the input state into UIEvent deliveries.
+
+  Each frame only the %game objects the hover moved in or out of receive Enter and Leave, and only the hovered
+  %game object and its ancestors, or the %game object that captured the mouse, receive the rest. %Game objects that
+  do not override IGameObject::OnUIEvent are never called, idle widgets therefore cost nothing.
+
+  @warning Used internally by the Jade Engine. Widgets interact with it through Game::CaptureMouse and Game::GetUIEventFrame.
+  @see UIEvent, IGameObject::OnUIEvent
+  */
+  class UIEventRouter
+  {
+  public:
+    /**
+    @param transformObjects %Game object owning the transform in each TransformSystem slot, used to walk up the transform hierarchy.
+    */
+    UIEventRouter(const std::vector<std::pair<Transform, IGameObject*>>& transformObjects);
+
+    UIEventRouter(const UIEventRouter&) = delete;
+    UIEventRouter& operator=(const UIEventRouter&) = delete;
+
+    /**
+    Deliver all events of the current frame.
+    */
+    void Dispatch(Sprite* hoveredSprite);
+
+    void SetCaptor(IGameObject* gameObject);
+    IGameObject* GetCaptor() const { return Resolve(_captor); }
+
+    uint64_t GetFrame() const { return _frame; }
+
+  private:
+    IGameObject* Resolve(const Transform& transform) const;
+    void CollectPath(Sprite* hoveredSprite);
+    void Deliver(UIEvent& event);
+
+    const std::vector<std::pair<Transform, IGameObject*>>& _transformObjects;
+
+    // Receivers from the target up to the topmost ancestor, only those overriding OnUIEvent
+    std::vector<IGameObject*> _path;
+    // Transforms of the receivers hovered in the previous frame, kept as handles so destroyed objects are told apart
+    std::vector<Transform> _hoveredPath;
+    std::vector<Transform> _nextHoveredPath;
+
+    Transform _captor;
+    uint64_t _frame;
+  };
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+namespace JadeEngine
+{
+  class IGameObject;
+
+  namespace detail
+  {
+    /**
+    %Game objects of a single class updated every frame, in one loop by a function instantiated for that class.
+
+    Objects which stop being updated every frame leave nullptr behind until the list is compacted.
+    */
+    struct UpdateList
+    {
+      void (*update)(std::vector<IGameObject*>& gameObjects);
+      std::vector<IGameObject*> gameObjects;
+      size_t emptySlots = 0;
+    };
+
+    struct ScheduledObject
+    {
+      IGameObject* gameObject;
+      uint32_t generation;
+      uint32_t list;
+      size_t listSlot;
+      size_t wokenSlot;
+      uint64_t nextFrame;
+    };
+
+    struct ScheduledWake
+    {
+      double at;
+      uint32_t slot;
+      uint32_t generation;
+
+      bool operator>(const ScheduledWake& other) const { return at > other.at; }
+    };
+  }
+
+  /**
+  Decides which %game objects of one scene are updated each frame according to their UpdatePolicy.
+
+  Objects updated every frame are kept in per-class lists. Sleeping objects are not visited at all,
+  they are only updated once woken - explicitly, by a WakeEvent or when their timer or frame interval runs out.
+
+  @see IGameObject::SetUpdatePolicy, IGameObject::Wake
+  */
+  class UpdateScheduler
+  {
+  public:
+    UpdateScheduler();
+
+    UpdateScheduler(const UpdateScheduler&) = delete;
+    UpdateScheduler& operator=(const UpdateScheduler&) = delete;
+
+    void Add(IGameObject* gameObject, void (*update)(std::vector<IGameObject*>&));
+    void Remove(IGameObject* gameObject);
+
+    /**
+    Update all objects due this frame.
+    */
+    void Update();
+
+    /**
+    Number of objects currently updated every frame.
+    */
+    size_t GetActiveCount() const { return _activeCount; }
+
+    /**
+    Number of objects managed by the scheduler, awake or not.
+    */
+    size_t GetCount() const { return _slots.size() - _freeSlots.size(); }
+
+  private:
+    friend class IGameObject;
+
+    void OnPolicyChanged(IGameObject* gameObject);
+    void Wake(IGameObject* gameObject);
+    void WakeAfter(IGameObject* gameObject, const float seconds);
+
+    void Activate(const uint32_t slot);
+    void Deactivate(const uint32_t slot);
+    void WakeSlot(const uint32_t slot);
+    void ScheduleFrame(const uint32_t slot);
+    void WakeDue();
+
+    std::vector<detail::ScheduledObject> _slots;
+    std::vector<uint32_t> _freeSlots;
+
+    std::deque<detail::UpdateList> _lists;
+    std::vector<uint32_t> _listIndices;
+    size_t _activeCount;
+
+    std::vector<uint32_t> _woken;
+    std::vector<uint32_t> _waking;
+
+    // Min-heaps of scheduler frames and scene time
+    std::vector<detail::ScheduledWake> _frameWakes;
+    std::vector<detail::ScheduledWake> _timeWakes;
+
+    uint64_t _frame;
+    double _time;
+  };
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace JadeEngine
+{
+  /**
+  Fixed set of threads executing jobs in the order they were pushed.
+
+  The thread that pushes jobs collects them back with WaitFinished in the order they finish, which allows it to process results as soon as they are ready.
+  Jobs must not touch the SDL2 renderer or any other state that is not thread-safe.
+
+  @code
+  WorkerPool pool(WorkerPool::GetDefaultWorkerCount());
+  for (auto& job : jobs)
+  {
+    pool.Push([&job]() { job.Decode(); });
+  }
+
+  size_t index;
+  while (pool.WaitFinished(index))
+  {
+    jobs[index].Upload();
+  }
+  @endcode
+  */
+  class WorkerPool
+  {
+  public:
+    WorkerPool(const size_t workerCount);
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    /**
+    Queue a job.
+
+    @returns Index of the job, starting from 0 in the order of pushing.
+    */
+    size_t Push(std::function<void()> job);
+
+    /**
+    Block until a job that was not yet returned finishes.
+
+    @param index Output index of the finished job as returned by Push.
+    @returns False if all pushed jobs were already returned.
+    */
+    bool WaitFinished(size_t& index);
+
+    size_t GetWorkerCount() const { return _workers.size(); }
+
+    /**
+    One worker per hardware thread, except the one calling WaitFinished.
+    */
+    static size_t GetDefaultWorkerCount();
+
+  private:
+    void WorkerLoop();
+
+    std::vector<std::thread> _workers;
+
+    std::mutex _mutex;
+    std::condition_variable _jobPushed;
+    std::condition_variable _jobFinished;
+    std::deque<std::pair<size_t, std::function<void()>>> _jobs;
+    std::deque<size_t> _finished;
+    size_t _pushedCount;
+    size_t _returnedCount;
+    bool _stopping;
+  };
+}
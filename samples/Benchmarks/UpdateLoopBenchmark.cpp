@@ -0,0 +1,156 @@
+// Compares the ways of updating a large population of objects: one loop over all objects calling Update through
+// the virtual table, one loop per class calling Class::Update directly the way detail::UpdateGameObjectsOfClass does,
+// and a plain loop over an array of structs as the lower bound. The per-class lists use PoolObjectAllocator like Game::Create.
+//
+// Standalone console program, needs no SDL2 libraries, only their headers. From this directory:
+//   cl /std:c++17 /O2 /EHsc /I..\..\include /I..\..\thirdparty\SDL2-2.0.8\include /I..\..\thirdparty\nlohmann\json
+//     UpdateLoopBenchmark.cpp ..\..\source\ObjectAllocator.cpp
+// GCC builds it with the same include directories and -fpermissive, which the setting specializations in EngineConstants.h need there.
+
+#include "ObjectAllocator.h"
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <new>
+#include <vector>
+
+using namespace JadeEngine;
+
+namespace
+{
+  const int32_t kObjects = 100000;
+  const int32_t kSweeps = 200;
+  const int32_t kRuns = 3;
+  const int32_t kLoaded = 2;
+
+  struct BenchmarkObject
+  {
+    virtual ~BenchmarkObject() {}
+    virtual void Update() {}
+    int32_t loadState = kLoaded;
+  };
+
+  struct MovingObject : BenchmarkObject
+  {
+    float x = 0.0f;
+    float velocity = 1.0f;
+    void Update() override { x += velocity * 0.016f; }
+  };
+
+  struct CountingObject : BenchmarkObject
+  {
+    int32_t count = 0;
+    void Update() override { count++; }
+  };
+
+  template<typename Class>
+  void UpdateObjectsOfClass(std::vector<BenchmarkObject*>& objects)
+  {
+    for (size_t i = 0; i < objects.size(); i++)
+    {
+      const auto object = static_cast<Class*>(objects[i]);
+      if (object != nullptr && object->loadState == kLoaded)
+      {
+        object->Class::Update();
+      }
+    }
+  }
+
+  template<typename Class>
+  BenchmarkObject* Create(IObjectAllocator& allocator)
+  {
+    return new (allocator.Allocate(0, detail::GetObjectTypeInfo<Class>())) Class();
+  }
+
+  template<typename Class>
+  void DestroyAll(IObjectAllocator& allocator, std::vector<BenchmarkObject*>& objects)
+  {
+    for (const auto object : objects)
+    {
+      object->~BenchmarkObject();
+      allocator.Deallocate(0, detail::GetObjectTypeInfo<Class>(), object);
+    }
+    objects.clear();
+  }
+
+  double Milliseconds()
+  {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count();
+  }
+}
+
+int32_t main(int32_t argc, char* argv[])
+{
+  // Mixed population on the heap with unrelated allocations in between, as before the per-class lists
+  std::vector<std::unique_ptr<BenchmarkObject>> mixed;
+  std::vector<std::unique_ptr<int32_t>> unrelated;
+
+  // Per-class lists allocated from the pool, as Game::Create stores them
+  PoolObjectAllocator pool;
+  std::vector<BenchmarkObject*> moving;
+  std::vector<BenchmarkObject*> counting;
+
+  for (int32_t i = 0; i < kObjects; i++)
+  {
+    if (i % 10 != 0)
+    {
+      mixed.push_back(std::make_unique<MovingObject>());
+      moving.push_back(Create<MovingObject>(pool));
+    }
+    else
+    {
+      mixed.push_back(std::make_unique<CountingObject>());
+      counting.push_back(Create<CountingObject>(pool));
+    }
+    unrelated.push_back(std::make_unique<int32_t>(i));
+  }
+
+  std::vector<MovingObject> plain(moving.size());
+
+  // The first run warms up the caches, compare the later ones
+  for (int32_t run = 0; run < kRuns; run++)
+  {
+    const auto mixedStart = Milliseconds();
+    for (int32_t sweep = 0; sweep < kSweeps; sweep++)
+    {
+      for (const auto& object : mixed)
+      {
+        if (object->loadState == kLoaded)
+        {
+          object->Update();
+        }
+      }
+    }
+
+    const auto perClassStart = Milliseconds();
+    for (int32_t sweep = 0; sweep < kSweeps; sweep++)
+    {
+      UpdateObjectsOfClass<MovingObject>(moving);
+      UpdateObjectsOfClass<CountingObject>(counting);
+    }
+
+    const auto plainStart = Milliseconds();
+    for (int32_t sweep = 0; sweep < kSweeps; sweep++)
+    {
+      for (auto& object : plain)
+      {
+        if (object.loadState == kLoaded)
+        {
+          object.x += object.velocity * 0.016f;
+        }
+      }
+    }
+    const auto plainEnd = Milliseconds();
+
+    printf("mixed virtual %.1f ms, per-class %.1f ms, plain %.1f ms (checksum %f)\n",
+      perClassStart - mixedStart, plainStart - perClassStart, plainEnd - plainStart,
+      static_cast<MovingObject*>(moving[0])->x + plain[0].x);
+  }
+
+  DestroyAll<MovingObject>(pool, moving);
+  DestroyAll<CountingObject>(pool, counting);
+  pool.ResetArena(0);
+
+  return 0;
+}
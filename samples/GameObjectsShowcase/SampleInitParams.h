@@ -47,6 +47,38 @@ const GameInitParams kSampleInitParams = {
   //int32_t minorVersion;
   1,
   //std::string hashVersion;
-  "4b825dc6"
+  "4b825dc6",
+  //bool packTextures;
+  true,
+  //bool deferTransformPropagation;
+  false,
+  //std::shared_ptr<IObjectAllocator> objectAllocator;
+  nullptr,
+  //std::string inputRecordingFile;
+  "",
+  //std::string inputReplayFile;
+  "",
+  //bool unthrottledReplay;
+  false,
+  //bool headless;
+  false,
+  //float headlessDeltaTime;
+  1.0f / 60.0f,
+  //uint32_t headlessFrames;
+  0,
+  //float fixedTimestep;
+  0.0f,
+  //uint32_t maxSimulationSteps;
+  5,
+  //uint32_t frameRateCap;
+  0,
+  //bool verticalSync;
+  true,
+  //bool skipIdleFrames;
+  false,
+  //uint32_t idleFrameTimeout;
+  100,
+  //bool partialRedraw;
+  false
 };
 
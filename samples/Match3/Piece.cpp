@@ -2,10 +2,10 @@
 
 #include "EngineTime.h"
 #include "Game.h"
-#include "Input.h"
 #include "SampleConstants.h"
 #include "Sprite.h"
 #include "Transform.h"
+#include "UIEvents.h"
 #include "Utils.h"
 
 #include <array>
@@ -143,20 +143,25 @@ namespace MatchThree
         _flashingMatchDone = true;
       }
     }
+  }
 
-    if (!_inputEnabled) return;
+  void Piece::OnUIEvent(UIEvent& event)
+  {
+    if (event.phase == kUIEventPhase_Capture)
+    {
+      return;
+    }
 
-    const auto hoveredSprite = GGame.GetHoveredSprite();
-    const auto hovered = hoveredSprite == _symbol || hoveredSprite == _background || hoveredSprite == _backgroundHovered || hoveredSprite == _backgroundSelected || hoveredSprite == _backgroundSelectedHovered;
-    if (hovered != _hovered)
+    // Hover is tracked even with input disabled so that it is correct once the input is enabled again
+    if (event.type == kUIEventType_Enter || event.type == kUIEventType_Leave)
     {
-      _hovered = hovered;
+      _hovered = event.type == kUIEventType_Enter;
       Show(IsShown());
     }
-
-    if (_hovered && GInput.MouseButtonPressed(SDL_BUTTON_LEFT))
+    else if (_inputEnabled && event.type == kUIEventType_Press && event.mouseButton == SDL_BUTTON_LEFT)
     {
       _selected = !_selected;
+      event.handled = true;
       Show(IsShown());
     }
   }
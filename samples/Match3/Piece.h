@@ -28,6 +28,7 @@ namespace MatchThree
   public:
     Piece(const PieceParams& params);
     void Update() override;
+    void OnUIEvent(UIEvent& event) override;
     void Show(const bool shown) override;
     void Clean() override;
     void Deselect();
@@ -42,8 +43,6 @@ namespace MatchThree
     void MoveCenterTo(const Vector2D_i32& pos, const float speed);
     void TeleportCenterTo(const Vector2D_i32& pos);
 
-    void SetZ(const int32_t z) { _z = z; }
-
     void FlashError();
     void FlashMatch();
     PieceType GetType() const { return _type; }
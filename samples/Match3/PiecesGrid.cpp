@@ -34,8 +34,6 @@ namespace MatchThree
     transform->Initialize({0, 0}, { GetTotalWidth(_columns, _pieceWidth, _piecesSpacing), GetTotalHeight(_rows, _pieceHeight, _piecesSpacing)});
     transform->SetCenterPosition(params.centerPosition);
 
-    GGame.StartBatchCreate();
-
     _pieces.resize(_rows * _columns);
 
     for (size_t row = 0; row < _rows; row++)
@@ -52,7 +50,6 @@ namespace MatchThree
       }
     }
 
-    GGame.EndBatchCreate();
     EvaluateMatches();
   }
 
@@ -385,7 +382,6 @@ namespace MatchThree
 
   void PiecesGrid::RefillGrid()
   {
-    GGame.StartBatchCreate();
     _piecesMovingMatch = true;
     for (size_t column = 0; column < _columns; ++column)
     {
@@ -426,7 +422,6 @@ namespace MatchThree
         _pieceToPiecesIndex[piece] = piecesIndex;
       }
     }
-    GGame.EndBatchCreate();
   }
 
   Vector2D_i32 PiecesGrid::GridPosition(const size_t row, const size_t column) const
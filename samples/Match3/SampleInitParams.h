@@ -51,6 +51,38 @@ namespace MatchThree
     //int32_t minorVersion;
     1,
     //std::string hashVersion;
-    "4b825dc6"
+    "4b825dc6",
+    //bool packTextures;
+    true,
+    //bool deferTransformPropagation;
+    true,
+    //std::shared_ptr<IObjectAllocator> objectAllocator;
+    nullptr,
+    //std::string inputRecordingFile;
+    "",
+    //std::string inputReplayFile;
+    "",
+    //bool unthrottledReplay;
+    false,
+    //bool headless;
+    false,
+    //float headlessDeltaTime;
+    1.0f / 60.0f,
+    //uint32_t headlessFrames;
+    0,
+    //float fixedTimestep;
+    0.0f,
+    //uint32_t maxSimulationSteps;
+    5,
+    //uint32_t frameRateCap;
+    0,
+    //bool verticalSync;
+    true,
+    //bool skipIdleFrames;
+    false,
+    //uint32_t idleFrameTimeout;
+    100,
+    //bool partialRedraw;
+    false
   };
 }
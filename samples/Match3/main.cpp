@@ -9,13 +9,50 @@
 #include "SampleConstants.h"
 #include "SampleInitParams.h"
 
+#include <cstdlib>
+#include <string>
+
 using namespace JadeEngine;
 using namespace MatchThree;
 
 int32_t main(int32_t argc, char* argv[])
 {
+  auto initParams = kSampleInitParams;
+
+  // A recorded session replayed unthrottled serves as a repeatable benchmark:
+  // Match3 --record session.bin, then Match3 --replay session.bin --unthrottled
+  // or without a display Match3 --replay session.bin --headless 0, where 0 runs until the recording ends
+  for (int32_t i = 1; i < argc; i++)
+  {
+    const std::string argument = argv[i];
+    if (argument == "--record" && i + 1 < argc)
+    {
+      initParams.inputRecordingFile = argv[++i];
+    }
+    else if (argument == "--replay" && i + 1 < argc)
+    {
+      initParams.inputReplayFile = argv[++i];
+    }
+    else if (argument == "--unthrottled")
+    {
+      initParams.unthrottledReplay = true;
+    }
+    else if (argument == "--headless" && i + 1 < argc)
+    {
+      // A frame count that is not a number is ignored like any other unknown argument
+      const auto frames = argv[++i];
+      char* end = nullptr;
+      const auto frameCount = std::strtoul(frames, &end, 10);
+      if (end != frames && *end == '\0')
+      {
+        initParams.headless = true;
+        initParams.headlessFrames = static_cast<uint32_t>(frameCount);
+      }
+    }
+  }
+
   auto& game = GGame;
-  if (game.Initialize(kSampleInitParams, argv))
+  if (game.Initialize(initParams, argv))
   {
     const auto poweredByJadeEngineScene = std::make_shared<PoweredByJadeEngineScene>();
     poweredByJadeEngineScene->SetNextScene(kScene_MainMenu);
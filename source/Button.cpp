@@ -3,16 +3,16 @@
 #include "Audio.h"
 #include "BoxSprite.h"
 #include "Game.h"
-#include "Input.h"
 #include "Text.h"
 #include "Transform.h"
+#include "UIEvents.h"
 
 namespace JadeEngine
 {
   Button::Button(const ButtonParams& params)
-    : _pressed(false)
+    : _pressedFrame(0)
     , _down(false)
-    , _released(false)
+    , _releasedFrame(0)
     , _disabled(false)
     , _hovered(false)
     , _normalTextColor(params.textColor)
@@ -119,46 +119,59 @@ namespace JadeEngine
     _text->transform->SetLocalPosition(0, offset);
   }
 
-  void Button::Update()
-  {
-    if (_pressed)
-    {
-      _pressed = false;
-    }
+  bool Button::Pressed() const { return _pressedFrame == GGame.GetUIEventFrame(); }
+  bool Button::Released() const { return _releasedFrame == GGame.GetUIEventFrame(); }
 
-    if (_released)
+  void Button::OnUIEvent(UIEvent& event)
+  {
+    if (event.phase == kUIEventPhase_Capture)
     {
-      _released = false;
+      return;
     }
 
-    const auto hoveredSprite = GGame.GetHoveredSprite();
-    _hovered = hoveredSprite == _normalSprite || (_hoveredSprite != nullptr && hoveredSprite == _hoveredSprite);
-
-    if (!_disabled && !_down && _hovered && GInput.MouseButtonPressed(SDL_BUTTON_LEFT))
+    switch (event.type)
     {
-      _down = true;
-      _pressed = true;
-      AdjustTextPosition();
-      if (!_clickSound.empty())
+    case kUIEventType_Enter:
+      _hovered = true;
+      Show(IsShown());
+      break;
+    case kUIEventType_Leave:
+      _hovered = false;
+      // Leaving the button cancels the press
+      if (_down)
       {
-        GAudio.PlaySound(_clickSound.c_str());
+        _down = false;
+        AdjustTextPosition();
       }
+      Show(IsShown());
+      break;
+    case kUIEventType_Press:
+      if (!_disabled && !_down && event.mouseButton == SDL_BUTTON_LEFT)
+      {
+        _down = true;
+        _pressedFrame = event.frame;
+        event.handled = true;
+        AdjustTextPosition();
+        Show(IsShown());
+        if (!_clickSound.empty())
+        {
+          GAudio.PlaySound(_clickSound.c_str());
+        }
+      }
+      break;
+    case kUIEventType_Release:
+      if (!_disabled && _down && event.mouseButton == SDL_BUTTON_LEFT)
+      {
+        _down = false;
+        _releasedFrame = event.frame;
+        event.handled = true;
+        AdjustTextPosition();
+        Show(IsShown());
+      }
+      break;
+    default:
+      break;
     }
-    else if (!_disabled && !_pressed && _down && hoveredSprite != _pressedSprite)
-    {
-      _down = false;
-      _pressed = false;
-      AdjustTextPosition();
-    }
-    else if (!_disabled && _down && !GInput.MouseButtonDown(SDL_BUTTON_LEFT))
-    {
-      _down = false;
-      _pressed = false;
-      _released = true;
-      AdjustTextPosition();
-    }
-
-    Show(IsShown());
   }
 
   void Button::Disable(bool disabled)
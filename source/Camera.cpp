@@ -104,9 +104,9 @@ namespace JadeEngine
     return { vector.x - _x, vector.y - _y };
   }
 
-  Box_i32 WorldCamera::WorldToScreen(const std::shared_ptr<Transform>& transform)
+  Box_i32 WorldCamera::WorldToScreen(const Transform& transform)
   {
-    assert(transform);
+    assert(transform.IsValid());
     return { transform->GetX() - _x, transform->GetY() - _y, transform->GetWidth(), transform->GetHeight() };
   }
 
@@ -1,9 +1,9 @@
 #include "Checkbox.h"
 
 #include "Game.h"
-#include "Input.h"
 #include "Sprite.h"
 #include "Transform.h"
+#include "UIEvents.h"
 
 #include <algorithm>
 
@@ -11,7 +11,7 @@ namespace JadeEngine
 {
   Checkbox::Checkbox(const CheckboxParams& params)
     : _checked(params.checked)
-    , _checkedChanged(false)
+    , _changedFrame(0)
   {
     SpriteParams spriteParams;
     spriteParams.layer = params.layer;
@@ -31,22 +31,21 @@ namespace JadeEngine
     transform->Attach(_emptySprite->transform, kZeroVector2D_i32, kAnchor_Center, kAnchor_Center);
   }
 
-  void Checkbox::Update()
+  bool Checkbox::Changed() const
   {
-    _checkedChanged = false;
+    return _changedFrame == GGame.GetUIEventFrame();
+  }
 
-    if (_shown)
+  void Checkbox::OnUIEvent(UIEvent& event)
+  {
+    if (event.phase != kUIEventPhase_Capture && event.type == kUIEventType_Press && event.mouseButton == SDL_BUTTON_LEFT && _shown)
     {
-      const auto hoverSprite = GGame.GetHoveredSprite();
-      if ((hoverSprite == _checkedSprite || hoverSprite == _emptySprite) &&
-        GInput.MouseButtonPressed(SDL_BUTTON_LEFT))
-      {
-        _checked = !_checked;
-        _checkedChanged = true;
-
-        _checkedSprite->Show(_checked);
-        _emptySprite->Show(!_checked);
-      }
+      _checked = !_checked;
+      _changedFrame = event.frame;
+      event.handled = true;
+
+      _checkedSprite->Show(_checked);
+      _emptySprite->Show(!_checked);
     }
   }
 
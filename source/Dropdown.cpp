@@ -6,6 +6,7 @@
 #include "Sprite.h"
 #include "Text.h"
 #include "Transform.h"
+#include "UIEvents.h"
 #include "Utils.h"
 
 namespace JadeEngine
@@ -18,7 +19,7 @@ namespace JadeEngine
     , _fontSize(params.textSize)
     , _fontColor(params.textColor)
     , _currentEntry(0)
-    , _changed(false)
+    , _changedFrame(0)
     , _layer(params.layer)
     , _scrollBarMargin(params.scrollBarMargin)
     , _maxVisibleEntries(params.maxEntries)
@@ -75,6 +76,10 @@ namespace JadeEngine
 
     transform->Initialize(kZeroVector2D_i32, { params.width, _entryHeight });
     transform->SetPosition(kZeroVector2D_i32);
+
+    // Input arrives through OnUIEvent, updates are only needed to follow the transform or while the scroll bar is dragged
+    SetUpdatePolicy(kUpdatePolicy_OnWake);
+    SetWakeEvents(kWakeEvent_TransformDirty);
   }
 
   void Dropdown::AddEntry(std::string text)
@@ -119,6 +124,9 @@ namespace JadeEngine
     _scrollBarSprite->transform->SetHeight(_entryHeight * (size-1) - _scrollBarMargin);
     _scrollBarSprite->Show(true);
     _scrollBarPointSprite->Show(true);
+
+    // Clicks outside of the expanded list have to reach it to contract it
+    GGame.CaptureMouse(this);
   }
 
   void Dropdown::Contract()
@@ -132,74 +140,108 @@ namespace JadeEngine
     _expandArrowSprite->Show(true);
     _scrollBarSprite->Show(false);
     _scrollBarPointSprite->Show(false);
+
+    if (_scrolling)
+    {
+      _scrolling = false;
+      SetUpdatePolicy(kUpdatePolicy_OnWake);
+    }
+
+    GGame.ReleaseMouse(this);
   }
 
-  void Dropdown::Update()
+  bool Dropdown::Changed() const
   {
-    _changed = false;
+    return _changedFrame == GGame.GetUIEventFrame();
+  }
 
-    auto hoveredSprite = GGame.GetHoveredSprite();
-    if (!_expanded && (hoveredSprite == _box || hoveredSprite == _expandArrowSprite) && GInput.MouseButtonPressed(SDL_BUTTON_LEFT))
+  void Dropdown::OnUIEvent(UIEvent& event)
+  {
+    if (event.phase == kUIEventPhase_Capture)
     {
-      _expanded = true;
-      Expand();
+      return;
     }
-    else if (_expanded && (hoveredSprite == _box || hoveredSprite == _contractArrowSprite) && GInput.MouseButtonPressed(SDL_BUTTON_LEFT))
+
+    // While expanded the mouse is captured, the sprite under the cursor tells where the click landed
+    const auto hoveredSprite = event.hoveredSprite;
+    if (event.type == kUIEventType_Press && event.mouseButton == SDL_BUTTON_LEFT)
     {
-      auto index = (GInput.GetMouseY() - transform->GetY()) / _entryHeight;
-      bool scrollBar = GInput.GetMouseX() > _box->transform->GetX() + _box->transform->GetWidth() - 2 * _scrollBarMargin - _scrollBarPointSprite->transform->GetWidth();
-      if (index == 0)
-      {
-        _expanded = false;
-        Contract();
-      }
-      else if (scrollBar)
+      event.handled = true;
+
+      if (!_expanded && (hoveredSprite == _box || hoveredSprite == _expandArrowSprite))
       {
-        _scrolling = true;
+        _expanded = true;
+        Expand();
       }
-      else if (_scrollOffset + (index - 1) == _currentEntry)
+      else if (_expanded && (hoveredSprite == _box || hoveredSprite == _contractArrowSprite))
       {
-        _expanded = false;
-        Contract();
+        Pick((GInput.GetMouseY() - transform->GetY()) / _entryHeight);
       }
-      else
+      else if (_expanded)
       {
-        _currentEntry = _scrollOffset + index-1;
         _expanded = false;
-        _changed = true;
         Contract();
-        UpdateEntries();
       }
     }
-    else if (_expanded && _scrolling)
+    else if (event.type == kUIEventType_Release && event.mouseButton == SDL_BUTTON_LEFT && _scrolling)
     {
-      if (GInput.MouseButtonDown(SDL_BUTTON_LEFT))
-      {
-        const auto y = Clamp(GInput.GetMouseY(), _scrollBarSprite->transform->GetY(), _scrollBarSprite->transform->GetY() + _scrollBarSprite->transform->GetHeight()) - _scrollBarSprite->transform->GetY();
-        _scrollBarPointSprite->transform->SetLocalPosition(0, y);
-        const auto t = static_cast<float>(y) / _scrollBarSprite->transform->GetHeight();
-        const auto index = static_cast<int32_t>((_entries.size()-1-_maxVisibleEntries) * t);
-        _scrollOffset = index;
-        UpdateEntries();
-      }
-      else
-      {
-        _scrolling = false;
-      }
+      _scrolling = false;
+      SetUpdatePolicy(kUpdatePolicy_OnWake);
     }
-    else if (_expanded && GInput.GetMouseWheelY() != 0)
+    else if (event.type == kUIEventType_Wheel && _expanded && !_scrolling)
     {
-      _scrollOffset = Clamp(_scrollOffset + GInput.GetMouseWheelY(), 0, static_cast<int32_t>(_entries.size() - 1 - _maxVisibleEntries));
-      const auto t = static_cast<float>(_scrollOffset) / (_entries.size() - 1 - _maxVisibleEntries);
-      const auto y = static_cast<int32_t>(t * _scrollBarSprite->transform->GetHeight());
-      _scrollBarPointSprite->transform->SetLocalPosition(0, y);
+      Scroll(event.wheelY);
+    }
+  }
 
-      UpdateEntries();
+  void Dropdown::Pick(const int32_t index)
+  {
+    const auto scrollBar = GInput.GetMouseX() > _box->transform->GetX() + _box->transform->GetWidth() - 2 * _scrollBarMargin - _scrollBarPointSprite->transform->GetWidth();
+    if (index == 0)
+    {
+      _expanded = false;
+      Contract();
+    }
+    else if (scrollBar)
+    {
+      _scrolling = true;
+      SetUpdatePolicy(kUpdatePolicy_EveryFrame);
+    }
+    else if (_scrollOffset + (index - 1) == _currentEntry)
+    {
+      _expanded = false;
+      Contract();
     }
-    else if (_expanded && (hoveredSprite != _box && hoveredSprite != _contractArrowSprite) && GInput.MouseButtonPressed(SDL_BUTTON_LEFT))
+    else
     {
+      _currentEntry = _scrollOffset + index-1;
+      _changedFrame = GGame.GetUIEventFrame();
       _expanded = false;
       Contract();
+      UpdateEntries();
+    }
+  }
+
+  void Dropdown::Scroll(const int32_t wheelY)
+  {
+    _scrollOffset = Clamp(_scrollOffset + wheelY, 0, static_cast<int32_t>(_entries.size() - 1 - _maxVisibleEntries));
+    const auto t = static_cast<float>(_scrollOffset) / (_entries.size() - 1 - _maxVisibleEntries);
+    const auto y = static_cast<int32_t>(t * _scrollBarSprite->transform->GetHeight());
+    _scrollBarPointSprite->transform->SetLocalPosition(0, y);
+
+    UpdateEntries();
+  }
+
+  void Dropdown::Update()
+  {
+    if (_expanded && _scrolling)
+    {
+      const auto y = Clamp(GInput.GetMouseY(), _scrollBarSprite->transform->GetY(), _scrollBarSprite->transform->GetY() + _scrollBarSprite->transform->GetHeight()) - _scrollBarSprite->transform->GetY();
+      _scrollBarPointSprite->transform->SetLocalPosition(0, y);
+      const auto t = static_cast<float>(y) / _scrollBarSprite->transform->GetHeight();
+      const auto index = static_cast<int32_t>((_entries.size()-1-_maxVisibleEntries) * t);
+      _scrollOffset = index;
+      UpdateEntries();
     }
 
     if (transform->IsDirty(kDirtyFlag_Position) || transform->IsDirty(kDirtyFlag_CenterPosition))
@@ -238,6 +280,13 @@ namespace JadeEngine
     IGameObject::Show(shown);
     const auto isShown = IsShown();
 
+    // A hidden dropdown must not keep the mouse captured
+    if (!isShown && _expanded)
+    {
+      _expanded = false;
+      Contract();
+    }
+
     _box->Show(isShown);
     _expandArrowSprite->Show(isShown && !_expanded);
     _contractArrowSprite->Show(isShown && _expanded);
@@ -2,9 +2,16 @@
 
 #include <algorithm>
 #include <cassert>
+#include <thread>
 
 using namespace JadeEngine::details;
 
+namespace
+{
+  // Below this much remaining time the pacer stops sleeping and yields instead
+  const auto kPacerSpinDuration = std::chrono::milliseconds(2);
+}
+
 namespace JadeEngine
 {
   Time GTime;
@@ -20,7 +27,7 @@ namespace JadeEngine
   void Time::Tick()
   {
     _now = std::chrono::steady_clock::now();
-    deltaTime = std::chrono::duration<float>(_now - _previousTick).count();
+    deltaTime = _fixedDeltaTime > 0.0f ? _fixedDeltaTime : std::chrono::duration<float>(_now - _previousTick).count();
     _previousTick = _now;
 
     for (auto iter = std::begin(_timeBoundTasks); iter != std::end(_timeBoundTasks);)
@@ -69,6 +76,49 @@ namespace JadeEngine
     return elapsedMiliseconds / 1000.0f;
   }
 
+  FramePacer::FramePacer()
+    : _period(std::chrono::steady_clock::duration::zero())
+  {
+  }
+
+  void FramePacer::SetFrameRateCap(const uint32_t framesPerSecond)
+  {
+    _period = framesPerSecond > 0
+      ? std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(1.0 / framesPerSecond))
+      : std::chrono::steady_clock::duration::zero();
+  }
+
+  void FramePacer::Wait()
+  {
+    if (_period == std::chrono::steady_clock::duration::zero())
+    {
+      return;
+    }
+
+    _nextFrame += _period;
+
+    auto now = std::chrono::steady_clock::now();
+    if (_nextFrame <= now)
+    {
+      // Late or the very first frame, the schedule starts over from now
+      _nextFrame = now;
+      return;
+    }
+
+    for (; now < _nextFrame; now = std::chrono::steady_clock::now())
+    {
+      const auto remaining = _nextFrame - now;
+      if (remaining > kPacerSpinDuration)
+      {
+        std::this_thread::sleep_for(remaining - kPacerSpinDuration);
+      }
+      else
+      {
+        std::this_thread::yield();
+      }
+    }
+  }
+
   void Time::RegisterTimeBoundTask(ITimeBoundTaskListener* task, const float maxDurationPerFrame)
   {
     assert(std::find_if(std::cbegin(_timeBoundTasks), std::cend(_timeBoundTasks), [&](const TimeBoundTask& timeBoundTask) { return timeBoundTask.listener == task; }) == std::cend(_timeBoundTasks));
@@ -13,11 +13,17 @@
 #include "IScene.h"
 #include "Input.h"
 #include "Persistence.h"
+#include "Profiler.h"
+#include "SkylinePacker.h"
 #include "Slider.h"
 #include "Sprite.h"
 #include "Text.h"
+#include "WorkerPool.h"
 
+#include <algorithm>
+#include <chrono>
 #include <fstream>
+#include <iomanip>
 #include <json.hpp>
 #include <SDL_image.h>
 #include <sstream>
@@ -29,12 +35,110 @@ namespace
 {
   const int32_t kDefaultTextureSize = 100;
 
+  // Beyond this many changed areas, or half of the screen, redrawing everything is cheaper than redrawing regions
+  const size_t kMaxRedrawRegions = 64;
+  const int64_t kMaxRedrawAreaDivisor = 2;
+
   const std::string kScalingSDLHintNames[3] =
   {
     "nearest", // kTextureSampling_Neareast
     "linear", // kTextureSampling_Linear
     "best", // kTextureSampling_Anisotropic
   };
+
+  struct DecodeJob
+  {
+    JadeEngine::AssetType type;
+    std::string assetName;
+    std::string file;
+    std::string sheetFile;
+    bool hitsRequired;
+    JadeEngine::TextureSampling sampling;
+    int32_t centerX;
+    int32_t centerY;
+
+    JadeEngine::detail::DecodedImageDescription image;
+    JadeEngine::detail::SpriteSheetDescription spriteSheet;
+    bool decoded;
+    float decodeTime;
+  };
+
+  float MillisecondsSince(const std::chrono::steady_clock::time_point& start)
+  {
+    return std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+  }
+
+  // Copy the image into the atlas page and repeat its border pixels around it so filtered sampling does not bleed in neighbours
+  void BlitExtruded(SDL_Surface* image, SDL_Surface* page, const SDL_Rect& placed)
+  {
+    const auto w = image->w;
+    const auto h = image->h;
+    const auto x = placed.x + 1;
+    const auto y = placed.y + 1;
+
+    const SDL_Rect blits[9][2] =
+    {
+      { { 0, 0, w, h },         { x, y, w, h } },
+      { { 0, 0, w, 1 },         { x, y - 1, w, 1 } },
+      { { 0, h - 1, w, 1 },     { x, y + h, w, 1 } },
+      { { 0, 0, 1, h },         { x - 1, y, 1, h } },
+      { { w - 1, 0, 1, h },     { x + w, y, 1, h } },
+      { { 0, 0, 1, 1 },         { x - 1, y - 1, 1, 1 } },
+      { { w - 1, 0, 1, 1 },     { x + w, y - 1, 1, 1 } },
+      { { 0, h - 1, 1, 1 },     { x - 1, y + h, 1, 1 } },
+      { { w - 1, h - 1, 1, 1 }, { x + w, y + h, 1, 1 } },
+    };
+
+    for (const auto& blit : blits)
+    {
+      auto destination = blit[1];
+      SDL_BlitSurface(image, &blit[0], page, &destination);
+    }
+  }
+
+  // Join overlapping regions until none overlap, returns false when a full redraw should be done instead
+  bool MergeRedrawRegions(std::vector<JadeEngine::Rectangle>& regions, const JadeEngine::Rectangle& target)
+  {
+    if (regions.size() > kMaxRedrawRegions)
+    {
+      return false;
+    }
+
+    regions.erase(std::remove_if(std::begin(regions), std::end(regions), [&target](JadeEngine::Rectangle& region)
+    {
+      return SDL_IntersectRect(&region, &target, &region) == SDL_FALSE;
+    }), std::end(regions));
+
+    for (auto merged = true; merged;)
+    {
+      merged = false;
+      for (size_t i = 0; i < regions.size(); i++)
+      {
+        for (size_t j = i + 1; j < regions.size();)
+        {
+          if (SDL_HasIntersection(&regions[i], &regions[j]) == SDL_TRUE)
+          {
+            SDL_UnionRect(&regions[i], &regions[j], &regions[i]);
+            regions[j] = regions.back();
+            regions.pop_back();
+            merged = true;
+          }
+          else
+          {
+            j++;
+          }
+        }
+      }
+    }
+
+    int64_t area = 0;
+    for (const auto& region : regions)
+    {
+      area += static_cast<int64_t>(region.w) * region.h;
+    }
+
+    return area * kMaxRedrawAreaDivisor <= static_cast<int64_t>(target.w) * target.h;
+  }
 }
 
 using namespace nlohmann;
@@ -49,10 +153,29 @@ namespace JadeEngine
     , _hoveredSprite(nullptr)
     , _fpsCount(0)
     , _fpsTimer(0.0f)
+    , _profilerText(nullptr)
     , _fullscreenChangedWanted(false)
     , _fullscreen(false)
     , _currentMode(-1)
-    , _batchCreate(false)
+    , _packTextures(false)
+    , _currentStorage(0)
+    , _persistentStorage(0)
+    , _headlessSurface(nullptr)
+    , _headless(false)
+    , _headlessFrames(0)
+    , _frames(0)
+    , _fixedTimestep(0.0f)
+    , _maxSimulationSteps(1)
+    , _accumulator(0.0f)
+    , _inputConsumed(true)
+    , _unthrottled(false)
+    , _skipIdleFrames(false)
+    , _idleFrameTimeout(0)
+    , _redrawWanted(true)
+    , _renderedScene(nullptr)
+    , _renderedCamera{ 0, 0 }
+    , _partialRedraw(false)
+    , _uiEvents(_transformObjects)
   {
   }
 
@@ -72,20 +195,83 @@ namespace JadeEngine
     _hashVersion = initParams.hashVersion;
     _author = initParams.author;
     _copyrightYear = initParams.copyrightYear;
+    _packTextures = initParams.packTextures;
+    GTransformSystem.SetDeferredPropagation(initParams.deferTransformPropagation);
+    _objectAllocator = initParams.objectAllocator ? initParams.objectAllocator : std::make_shared<PoolObjectAllocator>();
+    _headless = initParams.headless;
+    _headlessFrames = initParams.headlessFrames;
+    GTime.SetFixedDeltaTime(_headless ? initParams.headlessDeltaTime : 0.0f);
+    _fixedTimestep = initParams.fixedTimestep;
+    _maxSimulationSteps = std::max(initParams.maxSimulationSteps, 1u);
+    _framePacer.SetFrameRateCap(initParams.frameRateCap);
+
+    auto seed = std::random_device()();
+    if (!initParams.inputReplayFile.empty())
+    {
+      if (!_inputReplay.Open(initParams.inputReplayFile, _renderResolutionWidth, _renderResolutionHeight))
+      {
+        return false;
+      }
+      seed = _inputReplay.GetSeed();
+      GInput.SetMouseInRenderCoordinates(true);
+    }
+    else if (!initParams.inputRecordingFile.empty()
+      && !_inputRecorder.Open(initParams.inputRecordingFile, seed, _renderResolutionWidth, _renderResolutionHeight))
+    {
+      return false;
+    }
+    _re.seed(seed);
+
+    // A replay has no real input to wait for and a headless session never presents
+    _skipIdleFrames = initParams.skipIdleFrames && !_headless && !_inputReplay.IsOpen();
+    _idleFrameTimeout = initParams.idleFrameTimeout;
+    _partialRedraw = initParams.partialRedraw;
+    UpdateChangeTracking();
+    if (_fixedTimestep > 0.0f)
+    {
+      // Waiting longer than the simulation can catch up on would lose time
+      _idleFrameTimeout = std::min(_idleFrameTimeout, static_cast<uint32_t>(_fixedTimestep * _maxSimulationSteps * 1000.0f));
+    }
+
+    if (_headless)
+    {
+      // Neither needs a display or a sound device, keyboard and mouse state keep working as usual
+      SDL_setenv("SDL_VIDEODRIVER", "dummy", 1);
+      SDL_setenv("SDL_AUDIODRIVER", "dummy", 1);
+    }
 
     if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO) != 0)
     {
       return false;
     }
 
-    _window = SDL_CreateWindow(initParams.windowName.c_str(), 50, 50, _windowBufferRect.w, _windowBufferRect.h, SDL_WINDOW_SHOWN);
+    // Keycodes of keybindings can only be mapped to scancodes once the keyboard is initialized
+    GInput.RefreshKeymap();
 
-    if (_window == nullptr)
+    if (_headless)
     {
-      return false;
+      _headlessSurface = SDL_CreateRGBSurfaceWithFormat(0, _renderResolutionWidth, _renderResolutionHeight, 32, SDL_PIXELFORMAT_ARGB8888);
+      if (_headlessSurface == nullptr)
+      {
+        return false;
+      }
+
+      _renderer = SDL_CreateSoftwareRenderer(_headlessSurface);
+    }
+    else
+    {
+      _window = SDL_CreateWindow(initParams.windowName.c_str(), 50, 50, _windowBufferRect.w, _windowBufferRect.h, SDL_WINDOW_SHOWN);
+
+      if (_window == nullptr)
+      {
+        return false;
+      }
+
+      _unthrottled = _inputReplay.IsOpen() && initParams.unthrottledReplay;
+      const auto vsync = initParams.verticalSync && !_unthrottled;
+      _renderer = SDL_CreateRenderer(_window, -1, SDL_RENDERER_ACCELERATED | (vsync ? SDL_RENDERER_PRESENTVSYNC : 0));
     }
 
-    _renderer = SDL_CreateRenderer(_window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
     if (_renderer == nullptr)
     {
       return false;
@@ -160,12 +346,19 @@ namespace JadeEngine
     LoadAssets(initParams);
 
     _persistentScene = std::make_shared<IScene>();
+    RegisterScene(_persistentScene);
+    _persistentStorage = _persistentScene->GetStorageIndex();
     _currentScene = _persistentScene;
+    _currentStorage = _persistentStorage;
 
     _fpsText = Create<FTC>(kDefaultFPSFTCParams);
     _fpsText->transform->SetPosition(5, 5);
     _fpsText->SetIntValue(0, 0);
 
+    _profilerText = Create<FTC>(kDefaultProfilerFTCParams);
+    _profilerText->transform->SetPosition(5, 5 + _fpsText->transform->GetHeight());
+    _profilerText->Show(false);
+
     _clearColor = initParams.backgroundColor;
 
     return true;
@@ -173,53 +366,140 @@ namespace JadeEngine
 
   bool Game::LoadAssets(const GameInitParams& initParams)
   {
-    bool result = true;
+    const auto loadStart = std::chrono::steady_clock::now();
+
+    std::vector<DecodeJob> jobs;
+
+    const auto addImageJob = [&jobs](const AssetType type, const std::string& assetName, const std::string& file, const bool hitsRequired, const TextureSampling sampling) -> DecodeJob&
+    {
+      auto& job = jobs.emplace_back();
+      job.type = type;
+      job.assetName = assetName;
+      job.file = file;
+      job.hitsRequired = hitsRequired;
+      job.sampling = sampling;
+      return job;
+    };
 
     for (const auto& texture : initParams.textures)
     {
-      result &= LoadTexture(texture.assetName.c_str(), texture.fileLocation.c_str(), texture.generateHitMap, texture.sampling);
+      addImageJob(kAssetType_Texture, texture.assetName, texture.fileLocation, texture.generateHitMap, texture.sampling);
     }
     for (const auto& texture : kDefaultTextures)
     {
-      result &= LoadTexture(texture.assetName.c_str(), texture.fileLocation.c_str(), texture.generateHitMap, texture.sampling);
+      addImageJob(kAssetType_Texture, texture.assetName, texture.fileLocation, texture.generateHitMap, texture.sampling);
     }
 
-    for (const auto& font : initParams.fonts)
+    for (const auto& spritesheet : initParams.spritesheets)
     {
-      result &= LoadFont(initParams.fontSizes, font.assetName.c_str(), font.fileLocation.c_str());
+      addImageJob(kAssetType_SpriteSheet, spritesheet.assetName, spritesheet.textureFileLocation, false, spritesheet.sampling).sheetFile = spritesheet.sheetJSONFileLocation;
     }
-    for (const auto& font : kDefaultFonts)
+    for (const auto& spritesheet : kDefaultSpritesheets)
     {
-      result &= LoadFont(kDefaultFontSizes, font.assetName.c_str(), font.fileLocation.c_str());
+      addImageJob(kAssetType_SpriteSheet, spritesheet.assetName, spritesheet.textureFileLocation, false, spritesheet.sampling).sheetFile = spritesheet.sheetJSONFileLocation;
     }
 
-    for (const auto& sound : initParams.sounds)
+    for (const auto& cursor : initParams.cursors)
     {
-      result &= GAudio.LoadSound(sound.assetName.c_str(), sound.fileLocation.c_str());
+      auto& job = addImageJob(kAssetType_Cursor, cursor.assetName, cursor.fileLocation, false, kTextureSampling_Neareast);
+      job.centerX = cursor.centerX;
+      job.centerY = cursor.centerY;
     }
-    for (const auto& sound : kDefaultSounds)
+    for (const auto& cursor : kDefaultCursors)
     {
-      result &= GAudio.LoadSound(sound.assetName.c_str(), sound.fileLocation.c_str());
+      auto& job = addImageJob(kAssetType_Cursor, cursor.assetName, cursor.fileLocation, false, kTextureSampling_Neareast);
+      job.centerX = cursor.centerX;
+      job.centerY = cursor.centerY;
     }
 
-    for (const auto& cursor : initParams.cursors)
+    // Decoding does not need the renderer and runs on workers, only creating the SDL2 resources is left for this thread
+    WorkerPool workers(WorkerPool::GetDefaultWorkerCount());
+    for (auto& job : jobs)
+    {
+      workers.Push([this, &job]()
+      {
+        const auto decodeStart = std::chrono::steady_clock::now();
+        job.decoded = DecodeImage(job.file.c_str(), job.hitsRequired, job.image);
+        if (job.decoded && job.type == kAssetType_SpriteSheet)
+        {
+          job.decoded = DecodeSpriteSheet(job.assetName.c_str(), job.sheetFile.c_str(), job.spriteSheet);
+        }
+        job.decodeTime = MillisecondsSince(decodeStart);
+      });
+    }
+
+    _assetLoadReport = {};
+    _assetLoadReport.workerCount = workers.GetWorkerCount();
+
+    bool result = true;
+
+    // SDL2 TTF and Mixer are not thread-safe, fonts and sounds are loaded here while the workers decode images
+    const auto loadOnMainThread = [this, &result](const AssetType type, const std::string& assetName, const std::function<bool()>& load)
+    {
+      const auto decodeStart = std::chrono::steady_clock::now();
+      const auto success = load();
+      result &= success;
+      _assetLoadReport.assets.push_back({ assetName, type, MillisecondsSince(decodeStart), 0.0f, success });
+    };
+
+    for (const auto& font : initParams.fonts)
     {
-      result &= LoadCursor(cursor.assetName.c_str(), cursor.fileLocation.c_str(), cursor.centerX, cursor.centerY);
+      loadOnMainThread(kAssetType_Font, font.assetName, [&]() { return LoadFont(initParams.fontSizes, font.assetName.c_str(), font.fileLocation.c_str()); });
     }
-    for (const auto& cursor : kDefaultCursors)
+    for (const auto& font : kDefaultFonts)
     {
-      result &= LoadCursor(cursor.assetName.c_str(), cursor.fileLocation.c_str(), cursor.centerX, cursor.centerY);
+      loadOnMainThread(kAssetType_Font, font.assetName, [&]() { return LoadFont(kDefaultFontSizes, font.assetName.c_str(), font.fileLocation.c_str()); });
     }
 
-    for (const auto& spritesheet : initParams.spritesheets)
+    for (const auto& sound : initParams.sounds)
     {
-      result &= LoadSpritesheet(spritesheet.assetName.c_str(), spritesheet.textureFileLocation.c_str(), spritesheet.sheetJSONFileLocation.c_str(), spritesheet.sampling);
+      loadOnMainThread(kAssetType_Sound, sound.assetName, [&]() { return GAudio.LoadSound(sound.assetName.c_str(), sound.fileLocation.c_str()); });
     }
-    for (const auto& spritesheet : kDefaultSpritesheets)
+    for (const auto& sound : kDefaultSounds)
+    {
+      loadOnMainThread(kAssetType_Sound, sound.assetName, [&]() { return GAudio.LoadSound(sound.assetName.c_str(), sound.fileLocation.c_str()); });
+    }
+
+    size_t index;
+    while (workers.WaitFinished(index))
     {
-      result &= LoadSpritesheet(spritesheet.assetName.c_str(), spritesheet.textureFileLocation.c_str(), spritesheet.sheetJSONFileLocation.c_str(), spritesheet.sampling);
+      auto& job = jobs[index];
+      const auto uploadStart = std::chrono::steady_clock::now();
+
+      auto success = false;
+      if (job.decoded)
+      {
+        switch (job.type)
+        {
+        case kAssetType_Texture:
+          success = UploadTexture(job.assetName.c_str(), job.image, job.sampling, _packTextures);
+          break;
+        case kAssetType_SpriteSheet:
+          _spriteSheets[job.assetName] = std::move(job.spriteSheet);
+          success = UploadTexture(job.assetName.c_str(), job.image, job.sampling, false);
+          break;
+        case kAssetType_Cursor:
+          success = CreateCursor(job.assetName.c_str(), job.image.surface, job.centerX, job.centerY);
+          break;
+        default:
+          assert(false);
+          break;
+        }
+      }
+      else
+      {
+        SDL_FreeSurface(job.image.surface);
+      }
+
+      result &= success;
+      _assetLoadReport.assets.push_back({ job.assetName, job.type, job.decodeTime, MillisecondsSince(uploadStart), success });
     }
 
+    const auto packStart = std::chrono::steady_clock::now();
+    result &= PackTextures();
+    _assetLoadReport.packTime = MillisecondsSince(packStart);
+
+    _assetLoadReport.totalTime = MillisecondsSince(loadStart);
     return result;
   }
 
@@ -261,93 +541,79 @@ namespace JadeEngine
     }
   }
 
-  uint32_t Game::GetPixel(SDL_Surface* surface, int32_t x, int32_t y)
+  GlyphAtlas* Game::GetGlyphAtlas(TTF_Font* font)
   {
-    const auto bytesPerPixel = surface->format->BytesPerPixel;
-    const auto pixels = reinterpret_cast<uint8_t*>(surface->pixels);
-    const auto pixel = pixels + y * surface->pitch + x * bytesPerPixel;
+    if (font == nullptr)
+    {
+      return nullptr;
+    }
 
-    switch (bytesPerPixel)
+    auto& glyphAtlas = _glyphAtlases[font];
+    if (!glyphAtlas)
     {
-    case 1:
-      return *pixel;
-    case 2:
-      return *(reinterpret_cast<uint16_t*>(pixel));
-    case 4:
-      return *(reinterpret_cast<uint32_t*>(pixel));
+      glyphAtlas = std::make_unique<GlyphAtlas>(_renderer, font);
     }
 
-    return 0;
+    return glyphAtlas.get();
   }
 
-  void Game::GetBoundingBoxAndHitArray(SDL_Surface* surface, Rectangle& boundingBox, std::vector<bool>& hitArray, bool hitsRequired)
+  bool Game::GetBoundingBoxAndHitMask(SDL_Surface* surface, Rectangle& boundingBox, std::shared_ptr<const HitMask>& hitMask, bool hitsRequired)
   {
     if (hitsRequired)
     {
-      const auto lockedRequired = SDL_MUSTLOCK(surface);
-      if (lockedRequired)
-      {
-        SDL_LockSurface(surface);
-      }
-
-      int32_t minX = surface->w, maxX = 0, minY = surface->h, maxY = 0;
-      hitArray.resize(surface->w * surface->h, false);
-
-      for (int32_t x = 0; x < surface->w; x++)
+      hitMask = HitMask::Create(surface);
+      if (hitMask == nullptr)
       {
-        for (int32_t y = 0; y < surface->h; y++)
-        {
-          const auto pixel = GetPixel(surface, x, y);
-          uint8_t r, g, b, a;
-          SDL_GetRGBA(pixel, surface->format, &r, &g, &b, &a);
-
-          const auto hit = a > 0;
-          hitArray[x + y * surface->w] = hit;
-
-          if (hit)
-          {
-            minX = std::min(x, minX);
-            maxX = std::max(x, maxX);
-            minY = std::min(y, minY);
-            maxY = std::max(y, maxY);
-          }
-        }
+        return false;
       }
 
-      boundingBox = { minX, minY, maxX - minX, maxY - minY };
-
-      if (lockedRequired)
-      {
-        SDL_UnlockSurface(surface);
-      }
+      boundingBox = hitMask->GetOpaqueBounds();
     }
     else
     {
+      hitMask = nullptr;
       boundingBox = { 0, 0, surface->w, surface->h };
     }
+
+    return true;
   }
 
-  bool Game::LoadTexture(const char* assetName, const char* textureFile, const bool hitsRequired, const TextureSampling sampling)
+  bool Game::DecodeImage(const char* imageFile, const bool hitsRequired, DecodedImageDescription& image)
   {
-    const auto fullPath = AssetPathToAbsolute(textureFile);
+    image.surface = nullptr;
+
+    const auto fullPath = AssetPathToAbsolute(imageFile);
     if (fullPath.empty())
     {
       return false;
     }
 
-    auto imageSurface = IMG_Load(fullPath.c_str());
+    image.surface = IMG_Load(fullPath.c_str());
 
-    if (imageSurface == nullptr)
+    if (image.surface == nullptr)
     {
       return false;
     }
 
+    return GetBoundingBoxAndHitMask(image.surface, image.boundingBox, image.hitMask, hitsRequired);
+  }
+
+  bool Game::UploadTexture(const char* assetName, DecodedImageDescription& image, const TextureSampling sampling, const bool packable)
+  {
+    auto imageSurface = image.surface;
+    image.surface = nullptr;
+
     int32_t width = imageSurface->w, height = imageSurface->h;
     const auto format = imageSurface->format->format;
 
-    SDL_Rect boundingBox = {};
-    std::vector<bool> hitArray;
-    GetBoundingBoxAndHitArray(imageSurface, boundingBox, hitArray, hitsRequired);
+    if (packable && width <= kTextureAtlasMaxEntrySize && height <= kTextureAtlasMaxEntrySize)
+    {
+      // Texture is created later by PackTextures once all packable images are known
+      auto texture = std::make_shared<Texture>(nullptr, width, height, image.boundingBox, image.hitMask, assetName, format, false, sampling);
+      _textures[assetName] = texture;
+      _texturesToPack.emplace_back(texture, imageSurface);
+      return true;
+    }
 
     SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, kScalingSDLHintNames[sampling].c_str());
 
@@ -360,11 +626,105 @@ namespace JadeEngine
       return false;
     }
 
-    _textures[assetName] = std::make_shared<Texture>(imageTexture, width, height, boundingBox, hitArray, assetName, format, false, sampling);
+    _textures[assetName] = std::make_shared<Texture>(imageTexture, width, height, image.boundingBox, image.hitMask, assetName, format, false, sampling);
 
     return true;
   }
 
+  bool Game::PackTextures()
+  {
+    // Tallest first packs noticeably tighter with the skyline heuristic
+    std::stable_sort(std::begin(_texturesToPack), std::end(_texturesToPack), [](const auto& a, const auto& b)
+    {
+      // Ties are broken by name so the layout does not depend on the order workers finished decoding
+      if (a.first->height != b.first->height)
+      {
+        return a.first->height > b.first->height;
+      }
+      return a.first->name < b.first->name;
+    });
+
+    bool result = true;
+
+    // Sampling is a property of the whole texture so every sampling mode gets its own pages
+    for (int32_t sampling = kTextureSampling_Neareast; sampling <= kTextureSampling_Anisotropic; sampling++)
+    {
+      std::vector<std::pair<SDL_Surface*, SkylinePacker>> pages;
+      std::vector<std::pair<std::shared_ptr<Texture>, size_t>> packed;
+
+      for (const auto& toPack : _texturesToPack)
+      {
+        const auto& texture = toPack.first;
+        if (texture->sampling != sampling)
+        {
+          continue;
+        }
+
+        SDL_Rect placed;
+        if (pages.empty() || !pages.back().second.Insert(texture->width + 2, texture->height + 2, placed))
+        {
+          auto pageSurface = SDL_CreateRGBSurfaceWithFormat(0, kTextureAtlasPageSize, kTextureAtlasPageSize, 32, SDL_PIXELFORMAT_ARGB8888);
+          if (pageSurface == nullptr)
+          {
+            result = false;
+            break;
+          }
+
+          SDL_FillRect(pageSurface, nullptr, SDL_MapRGBA(pageSurface->format, 0, 0, 0, 0));
+          pages.emplace_back(pageSurface, SkylinePacker(kTextureAtlasPageSize, kTextureAtlasPageSize));
+          const auto inserted = pages.back().second.Insert(texture->width + 2, texture->height + 2, placed);
+          assert(inserted);
+        }
+
+        // Copy including alpha instead of blending over the transparent page
+        SDL_SetSurfaceBlendMode(toPack.second, SDL_BLENDMODE_NONE);
+        BlitExtruded(toPack.second, pages.back().first, placed);
+
+        texture->source = { placed.x + 1, placed.y + 1, texture->width, texture->height };
+        packed.emplace_back(texture, pages.size() - 1);
+      }
+
+      SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, kScalingSDLHintNames[sampling].c_str());
+
+      std::vector<SDL_Texture*> pageTextures;
+      for (auto& page : pages)
+      {
+        auto pageTexture = SDL_CreateTextureFromSurface(_renderer, page.first);
+        SDL_FreeSurface(page.first);
+
+        if (pageTexture == nullptr)
+        {
+          result = false;
+        }
+        else
+        {
+          SDL_SetTextureBlendMode(pageTexture, SDL_BLENDMODE_BLEND);
+          _textureAtlasPages.push_back(pageTexture);
+        }
+        pageTextures.push_back(pageTexture);
+      }
+
+      for (const auto& entry : packed)
+      {
+        entry.first->texture = pageTextures[entry.second];
+        entry.first->packed = pageTextures[entry.second] != nullptr;
+      }
+    }
+
+    for (auto& toPack : _texturesToPack)
+    {
+      SDL_FreeSurface(toPack.second);
+      if (toPack.first->texture == nullptr)
+      {
+        _textures.erase(toPack.first->name);
+        result = false;
+      }
+    }
+    _texturesToPack.clear();
+
+    return result;
+  }
+
   std::shared_ptr<Texture> Game::CopyTexture(const std::shared_ptr<Texture>& textureDesc, const TextureSampling sampling)
   {
     std::shared_ptr<Texture> result = std::make_shared<Texture>(*textureDesc);
@@ -378,8 +738,11 @@ namespace JadeEngine
     SDL_GetTextureBlendMode(textureDesc->texture, &mode);
     SDL_SetTextureBlendMode(result->texture, mode);
 
+    result->source = { 0, 0, textureDesc->width, textureDesc->height };
+    result->packed = false;
+
     SDL_SetRenderTarget(_renderer, result->texture);
-    SDL_RenderCopy(_renderer, textureDesc->texture, nullptr, nullptr);
+    SDL_RenderCopy(_renderer, textureDesc->texture, &textureDesc->source, nullptr);
     SDL_SetRenderTarget(_renderer, nullptr);
 
     _textureCopies.push_back(result);
@@ -412,7 +775,7 @@ namespace JadeEngine
       width,
       height,
       SDL_Rect{0, 0, width, height},
-      std::vector<bool>{},
+      nullptr,
       name,
       format,
       false,
@@ -422,17 +785,6 @@ namespace JadeEngine
     return true;
   }
 
-  static bool CompareGameObjectZ(const std::unique_ptr<IGameObject>& a, const std::unique_ptr<IGameObject>& b)
-  {
-    return a->GetZ() < b->GetZ();
-  }
-
-  void Game::SortGameObjectsRendering(const std::shared_ptr<IScene>& scene)
-  {
-    auto& gameObjects = _gameObjects[scene];
-    std::sort(std::begin(gameObjects), std::end(gameObjects), CompareGameObjectZ);
-  }
-
   std::string Game::HashSolidColorTexture(const uint32_t width, const uint32_t height,
     const SDL_Color& color)
   {
@@ -450,8 +802,6 @@ namespace JadeEngine
       return nullptr;
     }
 
-    auto& gameObjects = _gameObjects[_currentScene];
-
     const auto& key = HashSolidColorTexture(width, height, color);
 
     auto textureFound = _textures.find(key);
@@ -469,41 +819,149 @@ namespace JadeEngine
 
     auto& textureDesc = textureFound->second;
 
-    auto result = gameObjects.emplace_back(std::make_unique<Sprite>(layer, textureDesc, z)).get();
-    SortGameObjectsRendering(_currentScene);
+    auto result = static_cast<Sprite*>(AddGameObject(_currentStorage, AllocateGameObject<Sprite>(_currentStorage, layer, textureDesc, z), kObjectCapability_Renderable));
+    auto& storage = _sceneStorages[_currentStorage];
+    storage.renderQueue.Insert(result);
+    storage.spatialGrids[layer].Insert(result, result->transform->GetTestingBox());
 
-    return static_cast<std::add_pointer_t<Sprite>>(result);
+    return result;
   }
 
-  void Game::DestroyGameObject(IGameObject* gameObject)
+  IGameObject* Game::AddGameObject(const size_t storageIndex, GameObjectPtr gameObject, const uint8_t capabilities)
   {
-    assert(gameObject->DestructionWanted());
-    gameObject->Clean();
+    auto& storage = _sceneStorages[storageIndex];
 
-    _sprites.erase(gameObject);
+    const auto result = gameObject.get();
+    result->_capabilities |= capabilities;
+
+    if (const auto sprite = GameObjectToSprite(result))
+    {
+      if (sprite->HasHitTest())
+      {
+        result->_capabilities |= kObjectCapability_HitTestable;
+      }
+    }
+
+    const auto transformIndex = result->transform->GetIndex();
+    if (transformIndex >= _transformObjects.size())
+    {
+      _transformObjects.resize(transformIndex + 1);
+    }
+    _transformObjects[transformIndex] = { result->transform, result };
+
+    result->_sceneStorage = storageIndex;
+    result->_sceneSlot = storage.gameObjects.size();
+    result->_destructionQueue = &_pendingDestructions;
+
+    storage.gameObjects.push_back(std::move(gameObject));
+    storage.capabilities.push_back(result->_capabilities);
+
+    // Destroyed before the queue was known to it, e.g. by its parent's constructor
+    if (result->DestructionWanted())
+    {
+      _pendingDestructions.push_back(result);
+    }
+
+    return result;
   }
 
   void Game::DestroyGameObjects()
   {
-    for (auto& gameObjectsPair : _gameObjects)
+    // Clean can destroy further objects, such as children, which are appended to the queue and handled in the same pass
+    for (size_t i = 0; i < _pendingDestructions.size(); i++)
     {
-      auto& gameObjects = gameObjectsPair.second;
+      const auto gameObject = _pendingDestructions[i];
+      auto& storage = _sceneStorages[gameObject->_sceneStorage];
 
-      auto gameObjectsToRemove = std::remove_if(std::begin(gameObjects), std::end(gameObjects),[&](const std::unique_ptr<IGameObject>& element)
+      if (!_renderCaches.empty())
       {
-        if (element->DestructionWanted())
-        {
-          DestroyGameObject(element.get());
-        }
-        return element->DestructionWanted();
-      });
+        // The cached subtree loses a member, a destroyed root returns its texture
+        InvalidateRenderCaches(gameObject);
+        SetCachedAsTexture(gameObject, false);
+      }
+
+      gameObject->Clean();
+
+      storage.renderQueue.Remove(gameObject);
+
+      if (const auto sprite = GameObjectToSprite(gameObject))
+      {
+        storage.spatialGrids[sprite->GetLayer()].Remove(sprite);
+      }
+    }
+
+    // Only release once all are cleaned as Clean of one object may still access another
+    for (const auto gameObject : _pendingDestructions)
+    {
+      auto& storage = _sceneStorages[gameObject->_sceneStorage];
+
+      if (gameObject->_updateScheduler != nullptr)
+      {
+        storage.updateScheduler.Remove(gameObject);
+      }
+
+      if (gameObject == _hoveredSprite)
+      {
+        _hoveredSprite = nullptr;
+      }
+
+      storage.capabilities[gameObject->_sceneSlot] = 0;
+      storage.gameObjects[gameObject->_sceneSlot].reset();
+      storage.emptySlots++;
+
+      if (storage.emptySlots * 2 > storage.gameObjects.size())
+      {
+        CompactSceneStorage(storage);
+      }
+    }
+
+    _pendingDestructions.clear();
+  }
+
+  void Game::ReleaseGameObject(IGameObject* gameObject)
+  {
+    const auto memory = dynamic_cast<void*>(gameObject);
+    const auto objectType = gameObject->_objectType;
+    const auto arena = gameObject->_sceneStorage;
+
+    gameObject->~IGameObject();
+    _objectAllocator->Deallocate(arena, *objectType, memory);
+  }
+
+  void detail::GameObjectDeleter::operator()(IGameObject* gameObject) const
+  {
+    GGame.ReleaseGameObject(gameObject);
+  }
+
+  void Game::CompactSceneStorage(SceneStorage& storage)
+  {
+    auto& gameObjects = storage.gameObjects;
+    gameObjects.erase(std::remove(std::begin(gameObjects), std::end(gameObjects), nullptr), std::end(gameObjects));
+
+    storage.capabilities.resize(gameObjects.size());
+    for (size_t i = 0; i < gameObjects.size(); i++)
+    {
+      gameObjects[i]->_sceneSlot = i;
+      storage.capabilities[i] = gameObjects[i]->_capabilities;
+    }
 
-      gameObjects.erase(gameObjectsToRemove, std::end(gameObjects));
+    storage.emptySlots = 0;
+  }
+
+  void Game::RegisterScene(const std::shared_ptr<IScene>& scene)
+  {
+    if (scene->GetStorageIndex() == SIZE_MAX)
+    {
+      scene->SetStorageIndex(_sceneStorages.size());
+      _sceneStorages.emplace_back();
+      _sceneStorages.back().renderQueue.SetChangeTracking(TracksChanges());
     }
   }
 
   void Game::AddScene(const int32_t id, const std::shared_ptr<IScene>& scene)
   {
+    RegisterScene(scene);
+
     auto& sceneResult = _scenes[id];
     sceneResult = scene;
   }
@@ -514,6 +972,7 @@ namespace JadeEngine
     {
       _currentScene->SetActive(false);
       _currentScene = scene;
+      _currentStorage = _currentScene->GetStorageIndex();
       if (!_currentScene->GetInitialized())
       {
         _currentScene->SetInitialized(true);
@@ -525,7 +984,6 @@ namespace JadeEngine
 
   void Game::PlayScene(const int32_t id)
   {
-    _possibleSprites.clear();
     _hoveredSprite = nullptr;
 
     auto found = _scenes.find(id);
@@ -544,26 +1002,55 @@ namespace JadeEngine
 
     GPersistence.WriteSettings();
 
-    for (auto& scene : _scenes)
+    for (auto& storage : _sceneStorages)
     {
-      for (auto& textObject : _gameObjects[scene.second])
+      storage.renderQueue.Clear();
+      for (auto& spatialGrid : storage.spatialGrids)
+      {
+        spatialGrid.Clear();
+      }
+      for (auto& gameObject : storage.gameObjects)
       {
-        textObject->Clean();
+        if (gameObject)
+        {
+          gameObject->Clean();
+        }
       }
-      _gameObjects[scene.second].clear();
     }
+    const auto arenas = _sceneStorages.size();
+    _sceneStorages.clear();
+    _pendingDestructions.clear();
 
-    for (auto& texture : _textures)
+    _renderCaches.clear();
+    _renderTargets.Clear();
+
+    for (size_t arena = 0; arena < arenas; arena++)
     {
-      SDL_DestroyTexture(texture.second->texture);
+      _objectAllocator->ResetArena(arena);
     }
 
-    for (auto& texture : _textureCopies)
+    for (auto& texture : _textures)
+    {
+      if (!texture.second->packed)
+      {
+        SDL_DestroyTexture(texture.second->texture);
+      }
+    }
+
+    for (auto page : _textureAtlasPages)
+    {
+      SDL_DestroyTexture(page);
+    }
+    _textureAtlasPages.clear();
+
+    for (auto& texture : _textureCopies)
     {
       SDL_DestroyTexture(texture->texture);
     }
     _textureCopies.clear();
 
+    _glyphAtlases.clear();
+
     for (const auto& font : _fonts)
     {
       TTF_CloseFont(font.second.ttfFont);
@@ -587,6 +1074,11 @@ namespace JadeEngine
       SDL_DestroyRenderer(_renderer);
     }
 
+    if (_headlessSurface != nullptr)
+    {
+      SDL_FreeSurface(_headlessSurface);
+    }
+
     GAudio.CleanUp();
 
     TTF_Quit();
@@ -601,63 +1093,362 @@ namespace JadeEngine
       {
         _currentScene->SpriteHovered(_hoveredSprite, sprite);
       }
+
+      for (const auto changed : { _hoveredSprite, sprite })
+      {
+        if (changed != nullptr && changed->WakesOn(kWakeEvent_HoverChange))
+        {
+          changed->Wake();
+        }
+      }
     }
 
     _hoveredSprite = sprite;
   }
 
-  void Game::HoverSprites(std::shared_ptr<IScene>& scene)
+  void Game::ProcessEvent(const SDL_Event& event)
   {
-    for (auto& gameObject : _gameObjects[scene])
+    if (event.type == SDL_QUIT)
+    {
+      _quit = true;
+    }
+    else
     {
-      const auto sprite = GameObjectToSprite(gameObject.get());
-      if (sprite != nullptr && sprite->IsShown() && GUICamera.IsMouseInside(sprite, false) && GUICamera.IsMouseInside(sprite, true))
+      // Exposed, resized or restored windows need their content drawn again
+      if (event.type == SDL_WINDOWEVENT)
       {
-        _possibleSprites.push_back(sprite);
+        _redrawWanted = true;
       }
+      // So do render targets lost with the rendering device, the native render buffer included
+      else if (event.type == SDL_RENDER_TARGETS_RESET || event.type == SDL_RENDER_DEVICE_RESET)
+      {
+        _redrawWanted = true;
+        for (auto& renderCache : _renderCaches)
+        {
+          renderCache.second.state = detail::kRenderCacheState_Dirty;
+        }
+      }
+
+      GInput.ProcessMessage(event);
     }
   }
 
-  void Game::LoadGameObjects(std::shared_ptr<IScene>& scene)
+  void Game::SetCachedAsTexture(IGameObject* gameObject, const bool cached)
   {
-    for (auto& gameObject : _gameObjects[scene])
+    if (gameObject->_renderCacheRoot == cached)
     {
-      if (gameObject->GetLoadState() == kLoadState_Wanted)
+      return;
+    }
+
+    gameObject->_renderCacheRoot = cached;
+    if (cached)
+    {
+      _renderCaches[gameObject] = { detail::kRenderCacheState_Dirty, nullptr, { 0, 0, 0, 0 }, nullptr };
+    }
+    else
+    {
+      const auto renderCache = _renderCaches.find(gameObject);
+      _renderTargets.Release(renderCache->second.texture);
+      _renderCaches.erase(renderCache);
+    }
+
+    UpdateChangeTracking();
+    gameObject->Invalidate();
+  }
+
+  void Game::UpdateChangeTracking()
+  {
+    // Render queues only record changes somebody takes from them, otherwise their lists would grow forever
+    for (auto& storage : _sceneStorages)
+    {
+      storage.renderQueue.SetChangeTracking(TracksChanges());
+    }
+  }
+
+  IGameObject* Game::TransformToGameObject(const Transform& transform) const
+  {
+    const auto transformIndex = transform.GetIndex();
+    if (transformIndex >= _transformObjects.size() || _transformObjects[transformIndex].first != transform || !transform->IsValid())
+    {
+      return nullptr;
+    }
+
+    return _transformObjects[transformIndex].second;
+  }
+
+  void Game::InvalidateRenderCaches(IGameObject* gameObject)
+  {
+    for (auto transform = gameObject->transform; transform.IsValid(); transform = transform->GetParent())
+    {
+      const auto owner = TransformToGameObject(transform);
+      if (owner != nullptr && owner->_renderCacheRoot)
       {
-        gameObject->SetLoadState(gameObject->Load(_renderer));
+        _renderCaches[owner].state = detail::kRenderCacheState_Dirty;
       }
     }
   }
 
-  void Game::UpdateGameObjects(std::shared_ptr<IScene>& scene)
+  detail::RenderCache* Game::FindRenderCache(IGameObject* gameObject)
   {
-    for (auto& gameObject : _gameObjects[scene])
+    // The outermost usable cache wins, its texture already holds the subtrees of the caches inside it
+    detail::RenderCache* result = nullptr;
+    for (auto transform = gameObject->transform; transform.IsValid(); transform = transform->GetParent())
     {
-      if (gameObject->GetLoadState() == kLoadState_Done)
+      const auto owner = TransformToGameObject(transform);
+      if (owner == nullptr || !owner->_renderCacheRoot || !owner->IsShown() || owner->_sceneStorage != gameObject->_sceneStorage)
       {
-        gameObject->Update();
+        continue;
+      }
+
+      auto& renderCache = _renderCaches[owner];
+      if (renderCache.state == detail::kRenderCacheState_Valid)
+      {
+        result = &renderCache;
       }
     }
+
+    return result;
+  }
+
+  void Game::RebuildRenderCaches(std::shared_ptr<IScene>& scene)
+  {
+    const auto storageIndex = scene->GetStorageIndex();
+    const auto& renderQueue = _sceneStorages[storageIndex].renderQueue;
+    const Rectangle screen = { 0, 0, GetWidth(), GetHeight() };
+    auto rebuilt = false;
+
+    for (auto& [root, renderCache] : _renderCaches)
+    {
+      if (renderCache.state != detail::kRenderCacheState_Dirty || root->_sceneStorage != storageIndex)
+      {
+        continue;
+      }
+
+      _renderCacheMembers.clear();
+      auto cacheable = true;
+      Rectangle bounds = { 0, 0, 0, 0 };
+      for (const auto& entry : renderQueue)
+      {
+        const auto gameObject = entry.gameObject;
+        if (!gameObject->IsShown() || gameObject->GetRenderMode() == kRenderMode_None)
+        {
+          continue;
+        }
+
+        auto member = false;
+        for (auto transform = gameObject->transform; transform.IsValid() && !member; transform = transform->GetParent())
+        {
+          member = transform == root->transform;
+        }
+
+        if (!member)
+        {
+          continue;
+        }
+
+        // Nothing tells the engine when an object drawing directly changes
+        if (gameObject->GetRenderMode() == kRenderMode_Direct)
+        {
+          cacheable = false;
+          break;
+        }
+
+        const auto renderBounds = gameObject->GetRenderBounds();
+        SDL_UnionRect(&bounds, &renderBounds, &bounds);
+        _renderCacheMembers.push_back(entry);
+      }
+
+      renderCache.first = _renderCacheMembers.empty() ? nullptr : _renderCacheMembers.front().gameObject;
+      renderCache.state = detail::kRenderCacheState_Valid;
+
+      if (cacheable && SDL_IntersectRect(&bounds, &screen, &bounds) == SDL_FALSE)
+      {
+        // Nothing of the subtree is on screen, there is nothing to draw
+        renderCache.bounds = { 0, 0, 0, 0 };
+        continue;
+      }
+
+      int32_t textureWidth = 0;
+      int32_t textureHeight = 0;
+      if (cacheable && renderCache.texture != nullptr)
+      {
+        SDL_QueryTexture(renderCache.texture, nullptr, nullptr, &textureWidth, &textureHeight);
+      }
+
+      if (!cacheable || textureWidth < bounds.w || textureHeight < bounds.h)
+      {
+        _renderTargets.Release(renderCache.texture);
+        renderCache.texture = cacheable ? _renderTargets.Acquire(_renderer, _nativeTextureFormats, bounds.w, bounds.h) : nullptr;
+      }
+
+      if (renderCache.texture == nullptr)
+      {
+        renderCache.state = detail::kRenderCacheState_Uncacheable;
+        continue;
+      }
+
+      SDL_SetRenderTarget(_renderer, renderCache.texture);
+      SDL_SetRenderDrawColor(_renderer, 0, 0, 0, 0);
+      SDL_RenderClear(_renderer);
+
+      // The texture's origin is the top left corner of the subtree
+      _renderCommands.SetOffset(-bounds.x, -bounds.y);
+      for (const auto& entry : _renderCacheMembers)
+      {
+        _renderCommands.SetCurrentZ(entry.z);
+        entry.gameObject->Render(_renderer);
+      }
+      _renderCommands.Flush(_renderer);
+      _renderCommands.SetOffset(0, 0);
+
+      renderCache.bounds = bounds;
+      rebuilt = true;
+    }
+
+    if (rebuilt)
+    {
+      SDL_SetRenderTarget(_renderer, _nativeRenderBuffer);
+      SDL_SetRenderDrawColor(_renderer, _clearColor.r, _clearColor.g, _clearColor.b, 255);
+    }
+  }
+
+  void Game::ReleaseMouse(IGameObject* gameObject)
+  {
+    if (_uiEvents.GetCaptor() == gameObject)
+    {
+      _uiEvents.SetCaptor(nullptr);
+    }
+  }
+
+  Sprite* Game::HoverSprites(std::shared_ptr<IScene>& scene)
+  {
+    const auto isHovered = [](Sprite* sprite)
+    {
+      return sprite->IsShown() && GUICamera.IsMouseInside(sprite, false)
+        && (!sprite->HasCapability(kObjectCapability_HitTestable) || GUICamera.IsMouseInside(sprite, true));
+    };
+
+    const auto mouseX = GInput.GetMouseX();
+    const auto mouseY = GInput.GetMouseY();
+
+    Sprite* result = nullptr;
+    for (const auto& spatialGrid : _sceneStorages[scene->GetStorageIndex()].spatialGrids)
+    {
+      const auto sprite = spatialGrid.FindTopmost(mouseX, mouseY, isHovered);
+      if (sprite != nullptr && (result == nullptr || sprite->GetZ() > result->GetZ()))
+      {
+        result = sprite;
+      }
+    }
+
+    return result;
+  }
+
+  void Game::LoadGameObjects(std::shared_ptr<IScene>& scene)
+  {
+    auto& gameObjects = _sceneStorages[scene->GetStorageIndex()].gameObjects;
+
+    // Indexed as loading can create new objects
+    for (size_t i = 0; i < gameObjects.size(); i++)
+    {
+      const auto gameObject = gameObjects[i].get();
+      if (gameObject != nullptr && gameObject->GetLoadState() == kLoadState_Wanted)
+      {
+        gameObject->SetLoadState(gameObject->Load(_renderer));
+        gameObject->Invalidate();
+      }
+    }
+  }
+
+  void Game::UpdateGameObjects(std::shared_ptr<IScene>& scene)
+  {
+    _sceneStorages[scene->GetStorageIndex()].updateScheduler.Update();
   }
 
   void Game::UpdateGameObjectsTransforms(std::shared_ptr<IScene>& scene)
   {
-    for (auto& gameObject : _gameObjects[scene])
+    GTransformSystem.Propagate();
+    GTransformSystem.Update();
+
+    // Only the transforms that changed last frame are visited, a still scene costs nothing here
+    for (const auto& transform : GTransformSystem.GetDirtyTransforms())
     {
-      if (gameObject->GetLoadState() == kLoadState_Done)
+      const auto transformIndex = transform->GetIndex();
+      if (transformIndex >= _transformObjects.size() || _transformObjects[transformIndex].first != transform || !transform->IsValid())
       {
-        gameObject->transform->Update();
+        continue;
+      }
+
+      const auto gameObject = _transformObjects[transformIndex].second;
+      if (gameObject->WakesOn(kWakeEvent_TransformDirty))
+      {
+        gameObject->Wake();
+      }
+
+      if ((gameObject->_capabilities & kObjectCapability_Sprite) != 0
+        && (transform->IsDirty(kDirtyFlag_Position) || transform->IsDirty(kDirtyFlag_Size) || transform->IsDirty(kDirtyFlag_BoundingBox)))
+      {
+        const auto sprite = static_cast<Sprite*>(gameObject);
+        _sceneStorages[sprite->_sceneStorage].spatialGrids[sprite->GetLayer()].Move(sprite, transform->GetTestingBox());
       }
     }
   }
 
-  void Game::RenderGameObjects(std::shared_ptr<IScene>& scene)
+  void Game::RenderGameObjects(std::shared_ptr<IScene>& scene, const Rectangle* region)
   {
-    for (auto& gameObject : _gameObjects[scene])
+    for (const auto& entry : _sceneStorages[scene->GetStorageIndex()].renderQueue)
     {
-      if (gameObject->IsShown())
+      const auto gameObject = entry.gameObject;
+      const auto rendered = gameObject->IsShown() && gameObject->GetRenderMode() != kRenderMode_None;
+
+      if (region == nullptr && _partialRedraw)
+      {
+        gameObject->_renderedBounds = rendered ? gameObject->GetRenderBounds() : Rectangle{ 0, 0, 0, 0 };
+      }
+
+      // A cached subtree is drawn all at once from its texture in place of its lowest member
+      if (!_renderCaches.empty())
+      {
+        if (const auto renderCache = FindRenderCache(gameObject))
+        {
+          if (renderCache->first == gameObject && SDL_RectEmpty(&renderCache->bounds) == SDL_FALSE
+            && (region == nullptr || SDL_HasIntersection(&renderCache->bounds, region) == SDL_TRUE))
+          {
+            const Rectangle source = { 0, 0, renderCache->bounds.w, renderCache->bounds.h };
+            _renderCommands.SetCurrentZ(entry.z);
+            _renderCommands.Push(renderCache->texture, &source, renderCache->bounds, { 255, 255, 255, 255 });
+          }
+
+          continue;
+        }
+      }
+
+      if (!rendered || (region != nullptr && SDL_HasIntersection(&gameObject->_renderedBounds, region) == SDL_FALSE))
       {
+        continue;
+      }
+
+      switch (gameObject->GetRenderMode())
+      {
+      case kRenderMode_Commands:
+        _renderCommands.SetCurrentZ(entry.z);
         gameObject->Render(_renderer);
+        break;
+      case kRenderMode_Direct:
+        // Everything pushed so far must be on screen before the object draws over it
+        _renderCommands.Flush(_renderer);
+        if (region != nullptr)
+        {
+          SDL_RenderSetClipRect(_renderer, region);
+        }
+        gameObject->Render(_renderer);
+        if (region != nullptr)
+        {
+          SDL_RenderSetClipRect(_renderer, nullptr);
+        }
+        break;
+      case kRenderMode_None:
+        break;
       }
     }
   }
@@ -669,102 +1460,340 @@ namespace JadeEngine
       _fullscreenChangedWanted = false;
       _fullscreen = !_fullscreen;
       SDL_SetWindowFullscreen(_window, _fullscreen ? SDL_WINDOW_FULLSCREEN : 0);
+      _redrawWanted = true;
       return;
     }
 
+    GProfiler.BeginFrame();
+
     GTime.Tick();
 
+    if (_inputReplay.IsOpen() && !_inputReplay.NextFrame(GTime.deltaTime, _replayedEvents))
+    {
+      _quit = true;
+    }
+    else if (_inputRecorder.IsOpen())
+    {
+      _inputRecorder.BeginFrame(GTime.deltaTime);
+    }
+
     _fpsCount++;
     _fpsTimer += GTime.deltaTime;
     if (_fpsTimer >= 1.0f)
     {
       _fpsTimer -= 1.0f;
       _fpsText->SetIntValue(0, _fpsCount);
+      UpdateProfilerOverlay(_fpsCount);
       _fpsCount = 0;
     }
 
-    GInput.Update();
+    // Input of a frame that ran no simulation step is kept for the next one
+    if (_inputConsumed)
+    {
+      GInput.Update();
+      _inputConsumed = false;
+    }
 
     SDL_Event event;
     while (SDL_PollEvent(&event))
     {
-      if (event.type == SDL_QUIT)
+      if (_inputReplay.IsOpen() && event.type != SDL_QUIT)
       {
-        _quit = true;
+        // The real input is ignored while replaying, apart from closing the window
+        continue;
       }
-      else
+      else if (_inputRecorder.IsOpen())
       {
-        GInput.ProcessMessage(event);
+        _inputRecorder.Record(event);
       }
+
+      ProcessEvent(event);
     }
 
-    SDL_SetRenderDrawColor(_renderer, _clearColor.r, _clearColor.g, _clearColor.b, 255);
-    SDL_RenderClear(_renderer);
+    for (const auto& replayedEvent : _replayedEvents)
+    {
+      ProcessEvent(replayedEvent);
+    }
+    _replayedEvents.clear();
 
-    SDL_SetRenderTarget(_renderer, _nativeRenderBuffer);
-    SDL_RenderClear(_renderer);
+    if (_inputRecorder.IsOpen())
+    {
+      _inputRecorder.EndFrame();
+    }
 
-    DestroyGameObjects();
+    GInput.AfterMessages();
 
-    _possibleSprites.clear();
+    const auto frameDeltaTime = GTime.deltaTime;
+    uint32_t steps = 1;
+    if (_fixedTimestep > 0.0f)
+    {
+      // Time the simulation could not catch up on within the allowed steps is dropped, the game slows down instead of spiralling
+      _accumulator = std::min(_accumulator + frameDeltaTime, _fixedTimestep * _maxSimulationSteps);
+      steps = static_cast<uint32_t>(_accumulator / _fixedTimestep);
+      _accumulator -= steps * _fixedTimestep;
+      GTime.deltaTime = _fixedTimestep;
+    }
 
-    if (_currentScene)
+    const auto trackChanges = TracksChanges();
+    for (uint32_t step = 0; step < steps; step++)
     {
-      _currentScene->PreUpdate();
-      LoadGameObjects(_currentScene);
+      Simulate();
 
-      if (_currentScene != _persistentScene)
+      // Presses and releases are seen by the first step only
+      if (step == 0)
       {
-        LoadGameObjects(_persistentScene);
+        GInput.AfterUpdate();
+        _inputConsumed = true;
       }
 
-      HoverSprites(_currentScene);
+      // Each step's Simulate hides the transform changes of the previous one
+      if (trackChanges)
+      {
+        const auto& dirtyTransforms = GTransformSystem.GetDirtyTransforms();
+        _redrawTransforms.insert(std::end(_redrawTransforms), std::cbegin(dirtyTransforms), std::cend(dirtyTransforms));
+      }
     }
 
-    if (_possibleSprites.size() > 0)
+    GTime.deltaTime = frameDeltaTime;
+
+    auto fullRedraw = true;
+    const auto idle = trackChanges && !CollectRedraw(fullRedraw) && _skipIdleFrames;
+    if (!idle)
     {
-      std::sort(std::begin(_possibleSprites), std::end(_possibleSprites),
-        [](const Sprite* a, const Sprite* b) { return a->GetZ() > b->GetZ(); });
+      RenderFrame(fullRedraw || !_partialRedraw);
+    }
 
-      SetHoveredSprite(_possibleSprites[0]);
+    GPersistence.Update();
+
+    GProfiler.EndFrame();
+
+    if (_headless && _headlessFrames > 0 && ++_frames >= _headlessFrames)
+    {
+      _quit = true;
     }
-    else
+
+    if (idle)
     {
-      SetHoveredSprite(nullptr);
+      // The picture on screen is still up to date, sleep until there is input or the timeout lets timers advance
+      SDL_WaitEventTimeout(nullptr, _idleFrameTimeout);
+    }
+    else if (!_headless && !_unthrottled)
+    {
+      _framePacer.Wait();
+    }
+  }
+
+  bool Game::CollectRedraw(bool& fullRedraw)
+  {
+    fullRedraw = _redrawWanted;
+    _redrawWanted = false;
+
+    // Each queue has to be drained, it can not be skipped once a full redraw is certain
+    for (const auto& scene : { _currentScene, _persistentScene })
+    {
+      if (scene && _sceneStorages[scene->GetStorageIndex()].renderQueue.TakeInvalidated(_redrawObjects, _redrawRegions))
+      {
+        fullRedraw = true;
+      }
+    }
+
+    if (_currentScene.get() != _renderedScene)
+    {
+      _renderedScene = _currentScene.get();
+      fullRedraw = true;
+
+      // Changes made while the scene was not shown were not tracked
+      for (auto& renderCache : _renderCaches)
+      {
+        renderCache.second.state = detail::kRenderCacheState_Dirty;
+      }
     }
 
+    if (GWorldCamera.GetX() != _renderedCamera.x || GWorldCamera.GetY() != _renderedCamera.y)
+    {
+      _renderedCamera = { GWorldCamera.GetX(), GWorldCamera.GetY() };
+      fullRedraw = true;
+    }
+
+    // Moved and resized objects are not known to the render queues
+    for (const auto& transform : _redrawTransforms)
+    {
+      const auto transformIndex = transform->GetIndex();
+      if (transformIndex < _transformObjects.size() && _transformObjects[transformIndex].first == transform && transform->IsValid())
+      {
+        const auto gameObject = _transformObjects[transformIndex].second;
+        if (gameObject->_sceneStorage == _currentStorage || gameObject->_sceneStorage == _persistentStorage)
+        {
+          _redrawObjects.push_back(gameObject);
+        }
+      }
+    }
+    _redrawTransforms.clear();
+
+    if (!_renderCaches.empty())
+    {
+      for (const auto gameObject : _redrawObjects)
+      {
+        InvalidateRenderCaches(gameObject);
+      }
+    }
+
+    const auto changed = fullRedraw || !_redrawObjects.empty() || !_redrawRegions.empty();
+
+    if (_partialRedraw)
+    {
+      // Both where an object was and where it is now have to be drawn again
+      for (const auto gameObject : _redrawObjects)
+      {
+        if (SDL_RectEmpty(&gameObject->_renderedBounds) == SDL_FALSE)
+        {
+          _redrawRegions.push_back(gameObject->_renderedBounds);
+        }
+
+        gameObject->_renderedBounds = gameObject->IsShown() && gameObject->GetRenderMode() != kRenderMode_None
+          ? gameObject->GetRenderBounds() : Rectangle{ 0, 0, 0, 0 };
+
+        if (SDL_RectEmpty(&gameObject->_renderedBounds) == SDL_FALSE)
+        {
+          _redrawRegions.push_back(gameObject->_renderedBounds);
+        }
+      }
+
+      fullRedraw = fullRedraw || !MergeRedrawRegions(_redrawRegions, { 0, 0, GetWidth(), GetHeight() });
+    }
+    _redrawObjects.clear();
+
+    return changed;
+  }
+
+  void Game::RenderFrame(const bool fullRedraw)
+  {
+    SDL_SetRenderDrawColor(_renderer, _clearColor.r, _clearColor.g, _clearColor.b, 255);
+    if (!_headless)
+    {
+      SDL_RenderClear(_renderer);
+    }
+
+    SDL_SetRenderTarget(_renderer, _nativeRenderBuffer);
+
+    {
+      ScopedProfilerPhase phase(kProfilerPhase_Render);
+      _renderCommands.BeginFrame(GetWidth(), GetHeight());
+
+      if (!_renderCaches.empty())
+      {
+        RebuildRenderCaches(_currentScene);
+        RebuildRenderCaches(_persistentScene);
+      }
+
+      if (fullRedraw)
+      {
+        SDL_RenderClear(_renderer);
+        RenderGameObjects(_currentScene, nullptr);
+        RenderGameObjects(_persistentScene, nullptr);
+      }
+      else
+      {
+        // The native render buffer still holds the last frame, only the changed regions are cleared and drawn again
+        SDL_SetRenderDrawBlendMode(_renderer, SDL_BLENDMODE_NONE);
+        for (const auto& region : _redrawRegions)
+        {
+          SDL_SetRenderDrawColor(_renderer, _clearColor.r, _clearColor.g, _clearColor.b, 255);
+          SDL_RenderFillRect(_renderer, &region);
+          _renderCommands.SetClip(&region);
+          RenderGameObjects(_currentScene, &region);
+          RenderGameObjects(_persistentScene, &region);
+          _renderCommands.Flush(_renderer);
+        }
+        _renderCommands.SetClip(nullptr);
+      }
+
+      _redrawRegions.clear();
+      _renderCommands.EndFrame(_renderer);
+    }
+
+    // Headless frames stay in the native render buffer, there is nothing to present them to
+    if (!_headless)
+    {
+      ScopedProfilerPhase phase(kProfilerPhase_Present);
+      SDL_SetRenderTarget(_renderer, nullptr);
+
+      SDL_Rect finalRect = {
+        (_windowBufferRect.w - _scaledBufferRect.w) / 2,
+        (_windowBufferRect.h - _scaledBufferRect.h) / 2,
+        _scaledBufferRect.w,
+        _scaledBufferRect.h
+      };
+      SDL_RenderCopy(_renderer, _nativeRenderBuffer, nullptr,
+        &finalRect);
+
+      SDL_RenderPresent(_renderer);
+    }
+  }
+
+  float Game::GetInterpolationAlpha() const
+  {
+    return _fixedTimestep > 0.0f ? _accumulator / _fixedTimestep : 1.0f;
+  }
+
+  void Game::Simulate()
+  {
+    {
+      ScopedProfilerPhase phase(kProfilerPhase_Destroy);
+      DestroyGameObjects();
+    }
+
+    Sprite* hoveredSprite = nullptr;
+
     if (_currentScene)
     {
-      UpdateGameObjects(_currentScene);
-      if (_currentScene != _persistentScene)
+      _currentScene->PreUpdate();
+
       {
-        UpdateGameObjects(_persistentScene);
+        ScopedProfilerPhase phase(kProfilerPhase_Load);
+        LoadGameObjects(_currentScene);
+
+        if (_currentScene != _persistentScene)
+        {
+          LoadGameObjects(_persistentScene);
+        }
       }
 
-      _currentScene->Update();
-      LoadGameObjects(_currentScene);
-      UpdateGameObjectsTransforms(_currentScene);
+      ScopedProfilerPhase phase(kProfilerPhase_Hover);
+      hoveredSprite = HoverSprites(_currentScene);
     }
 
-    RenderGameObjects(_currentScene);
-    RenderGameObjects(_persistentScene);
+    SetHoveredSprite(hoveredSprite);
 
-    SDL_SetRenderTarget(_renderer, nullptr);
+    if (_currentScene)
+    {
+      {
+        ScopedProfilerPhase phase(kProfilerPhase_Hover);
+        _uiEvents.Dispatch(_hoveredSprite);
+      }
 
-    SDL_Rect finalRect = {
-      (_windowBufferRect.w - _scaledBufferRect.w) / 2,
-      (_windowBufferRect.h - _scaledBufferRect.h) / 2,
-      _scaledBufferRect.w,
-      _scaledBufferRect.h
-    };
-    SDL_RenderCopy(_renderer, _nativeRenderBuffer, nullptr,
-      &finalRect);
+      {
+        ScopedProfilerPhase phase(kProfilerPhase_UpdateGameObjects);
+        UpdateGameObjects(_currentScene);
+        if (_currentScene != _persistentScene)
+        {
+          UpdateGameObjects(_persistentScene);
+        }
+      }
 
-    SDL_RenderPresent(_renderer);
+      {
+        ScopedProfilerPhase phase(kProfilerPhase_SceneUpdate);
+        _currentScene->Update();
+      }
 
-    GPersistence.Update();
+      {
+        ScopedProfilerPhase phase(kProfilerPhase_Load);
+        LoadGameObjects(_currentScene);
+      }
 
-    GInput.AfterUpdate();
+      ScopedProfilerPhase phase(kProfilerPhase_UpdateTransforms);
+      UpdateGameObjectsTransforms(_currentScene);
+    }
   }
 
   void Game::Start()
@@ -810,6 +1839,16 @@ namespace JadeEngine
 
   void Game::CollectDisplayModes()
   {
+    if (_headless)
+    {
+      // Without a display the rendering resolution is the only mode, window coordinates then match it exactly
+      const Rectangle rect = { 0, 0, _renderResolutionWidth, _renderResolutionHeight };
+      const auto name = std::to_string(_renderResolutionWidth) + "x" + std::to_string(_renderResolutionHeight) + " (Native)";
+      _displayModes.push_back({ _renderResolutionWidth, _renderResolutionHeight, 1, true, name, rect, rect, 0 });
+      _currentMode = 0;
+      return;
+    }
+
     std::unordered_map<DisplayModeInfoKey, DisplayModeInfo> displayModes;
 
     const auto numDisplays = SDL_GetNumVideoDisplays();
@@ -933,6 +1972,7 @@ namespace JadeEngine
       SDL_SetWindowSize(_window, _windowBufferRect.w, _windowBufferRect.h);
       GUICamera.SetDisplayMode(_scaledBufferRect, _windowBufferRect);
       _currentMode = index;
+      _redrawWanted = true;
     }
   }
 
@@ -947,25 +1987,13 @@ namespace JadeEngine
     return textureFound->second;
   }
 
-  bool Game::LoadCursor(const char* assetName, const char* textureFile, int32_t centerX, int32_t centerY)
+  bool Game::CreateCursor(const char* assetName, SDL_Surface* imageSurface, int32_t centerX, int32_t centerY)
   {
-    const auto fullPath = AssetPathToAbsolute(textureFile);
-    if (fullPath.empty())
-    {
-      return false;
-    }
-
-    auto imageSurface = IMG_Load(fullPath.c_str());
-
-    if (imageSurface == nullptr)
-    {
-      return false;
-    }
-
     auto sdlCursor = SDL_CreateColorCursor(imageSurface, centerX, centerY);
 
     if (sdlCursor == nullptr)
     {
+      SDL_FreeSurface(imageSurface);
       return false;
     }
 
@@ -974,7 +2002,7 @@ namespace JadeEngine
     return true;
   }
 
-  bool Game::LoadSpritesheet(const char* assetName, const char* textureFile, const char* sheetFile, const TextureSampling sampling)
+  bool Game::DecodeSpriteSheet(const char* assetName, const char* sheetFile, SpriteSheetDescription& spriteSheet)
   {
     const auto fullPath = AssetPathToAbsolute(sheetFile);
     if (fullPath.empty())
@@ -1006,11 +2034,11 @@ namespace JadeEngine
       rect.h = frame["frame"]["h"].get<int32_t>();
 
       const auto name = frame["filename"].get<std::string>();
-      _spriteSheets[assetName].textureName = assetName;
-      _spriteSheets[assetName].sprites[name].rect = rect;
+      spriteSheet.textureName = assetName;
+      spriteSheet.sprites[name].rect = rect;
     }
 
-    return LoadTexture(assetName, textureFile, false, sampling);
+    return true;
   }
 
   void Game::SetCursor(const std::string& name)
@@ -1022,10 +2050,44 @@ namespace JadeEngine
     }
   }
 
-  void Game::EndBatchCreate()
+  void Game::ShowProfilerOverlay(const bool shown)
   {
-    _batchCreate = false;
-    SortGameObjectsRendering(_currentScene);
+    if (_profilerText != nullptr)
+    {
+      _profilerText->Show(shown);
+    }
+  }
+
+  bool Game::IsProfilerOverlayShown() const
+  {
+    return _profilerText != nullptr && _profilerText->IsShown();
+  }
+
+  void Game::UpdateProfilerOverlay(const size_t frames)
+  {
+    if (!IsProfilerOverlayShown())
+    {
+      return;
+    }
+
+    const auto average = GProfiler.GetAverage(frames);
+
+    std::stringstream stream;
+    stream << std::fixed << std::setprecision(2) << average.frameTime;
+    _profilerText->SetStringValue(0, stream.str());
+
+    for (size_t i = 0; i < kProfilerPhase_Count; i++)
+    {
+      stream.str(std::string());
+      stream << average.phaseTimes[i];
+      _profilerText->SetStringValue(static_cast<uint32_t>(i + 1), stream.str());
+    }
+
+    const auto& renderStats = _renderCommands.GetLastFrameStats();
+    _profilerText->SetIntValue(kProfilerPhase_Count + 1, renderStats.drawCalls);
+    _profilerText->SetIntValue(kProfilerPhase_Count + 2, renderStats.commands);
+    _profilerText->SetIntValue(kProfilerPhase_Count + 3, renderStats.textureSwitches);
+    _profilerText->SetIntValue(kProfilerPhase_Count + 4, renderStats.unsortedTextureSwitches);
   }
 
   void Game::UpdateKeybindings()
@@ -1033,6 +2095,7 @@ namespace JadeEngine
     for (auto& keybinding : _keybindings)
     {
       keybinding.second.key = GPersistence.GetSetting<int32_t>(keybinding.first);
+      GInput.SetKeybind(keybinding.first, keybinding.second.key);
     }
   }
 
@@ -1117,7 +2180,7 @@ namespace JadeEngine
 
   Sprite* Game::GameObjectToSprite(IGameObject* gameObject)
   {
-    if (_sprites.count(gameObject) > 0U)
+    if (gameObject->HasCapability(kObjectCapability_Sprite))
     {
       return static_cast<Sprite*>(gameObject);
     }
@@ -0,0 +1,341 @@
+#include "GlyphAtlas.h"
+
+#include "Utils.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace
+{
+  const int32_t kGlyphPadding = 1;
+  const uint16_t kReplacementCodePoint = '?';
+  const uint16_t kNewLineCodePoint = '\n';
+  const uint16_t kSpaceCodePoint = ' ';
+
+  // SDL2 TTF glyph functions only accept UCS-2, anything outside of it or malformed is replaced
+  void DecodeUTF8(const std::string& text, std::vector<uint16_t>& codePoints)
+  {
+    codePoints.clear();
+    codePoints.reserve(text.size());
+
+    const auto bytes = reinterpret_cast<const uint8_t*>(text.data());
+    const auto size = text.size();
+
+    for (size_t i = 0; i < size;)
+    {
+      const auto lead = bytes[i];
+      uint32_t codePoint = 0;
+      size_t length = 0;
+
+      if (lead < 0x80)
+      {
+        codePoint = lead;
+        length = 1;
+      }
+      else if ((lead & 0xE0) == 0xC0)
+      {
+        codePoint = lead & 0x1F;
+        length = 2;
+      }
+      else if ((lead & 0xF0) == 0xE0)
+      {
+        codePoint = lead & 0x0F;
+        length = 3;
+      }
+      else if ((lead & 0xF8) == 0xF0)
+      {
+        codePoint = lead & 0x07;
+        length = 4;
+      }
+      else
+      {
+        codePoints.push_back(kReplacementCodePoint);
+        i++;
+        continue;
+      }
+
+      bool valid = i + length <= size;
+      for (size_t j = 1; valid && j < length; j++)
+      {
+        valid = (bytes[i + j] & 0xC0) == 0x80;
+        codePoint = (codePoint << 6) | (bytes[i + j] & 0x3F);
+      }
+
+      if (!valid)
+      {
+        codePoints.push_back(kReplacementCodePoint);
+        i++;
+        continue;
+      }
+
+      i += length;
+
+      if (codePoint == '\r' || codePoint == 0xFEFF || codePoint == 0xFFFE)
+      {
+        // Carriage returns are dropped and byte order marks would be interpreted by TTF_RenderUNICODE_Blended
+        continue;
+      }
+
+      codePoints.push_back(codePoint > 0xFFFF ? kReplacementCodePoint : static_cast<uint16_t>(codePoint));
+    }
+  }
+}
+
+namespace JadeEngine
+{
+  GlyphAtlas::GlyphAtlas(SDL_Renderer* renderer, TTF_Font* font)
+    : _renderer(renderer)
+    , _font(font)
+    , _fontHeight(TTF_FontHeight(font))
+    , _lineSkip(TTF_FontLineSkip(font))
+    , _kerning(TTF_GetFontKerning(font) != 0)
+  {
+    assert(_renderer != nullptr);
+    assert(_font != nullptr);
+  }
+
+  GlyphAtlas::~GlyphAtlas()
+  {
+    for (const auto& page : _pages)
+    {
+      SDL_DestroyTexture(page.texture);
+    }
+  }
+
+  int32_t GlyphAtlas::GetKerning(const uint16_t previous, const uint16_t current) const
+  {
+    return _kerning ? TTF_GetFontKerningSizeGlyphs(_font, previous, current) : 0;
+  }
+
+  detail::GlyphAtlasPage* GlyphAtlas::AllocatePageSpace(const int32_t width, const int32_t height, Rectangle& source)
+  {
+    auto page = _pages.empty() ? nullptr : &_pages.back();
+
+    if (page != nullptr && page->cursorX + width > page->size)
+    {
+      // All glyphs are rasterized with the height of the font, so rows are simply font height tall
+      page->cursorX = 0;
+      page->cursorY += _fontHeight + kGlyphPadding;
+    }
+
+    if (page == nullptr || page->cursorY + height > page->size)
+    {
+      const auto size = std::max({ kGlyphAtlasPageSize, width, height });
+
+      auto texture = SDL_CreateTexture(_renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, size, size);
+      if (texture == nullptr)
+      {
+        return nullptr;
+      }
+
+      // Static textures start undefined, glyphs rely on transparent surroundings
+      std::vector<uint32_t> clear(static_cast<size_t>(size) * size, 0);
+      SDL_ASSERT_SUCCESS(SDL_UpdateTexture(texture, nullptr, clear.data(), size * sizeof(uint32_t)));
+      SDL_ASSERT_SUCCESS(SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND));
+
+      _pages.push_back({ texture, size, 0, 0 });
+      page = &_pages.back();
+    }
+
+    source = { page->cursorX, page->cursorY, width, height };
+    page->cursorX += width + kGlyphPadding;
+
+    return page;
+  }
+
+  bool GlyphAtlas::RasterizeGlyph(const uint16_t codePoint, detail::GlyphAtlasEntry& entry)
+  {
+    int minX = 0, maxX = 0, minY = 0, maxY = 0, advance = 0;
+    if (TTF_GlyphMetrics(_font, codePoint, &minX, &maxX, &minY, &maxY, &advance) != 0)
+    {
+      return false;
+    }
+
+    entry.texture = nullptr;
+    entry.source = { 0, 0, 0, 0 };
+    entry.advance = advance;
+    // Single glyph surface starts at the glyph's left-most pixel when it reaches left of the pen, see TTF_SizeUNICODE
+    entry.offsetX = std::min(0, minX);
+
+    if (codePoint == kSpaceCodePoint || codePoint == kNewLineCodePoint)
+    {
+      return true;
+    }
+
+    const Uint16 text[2] = { codePoint, 0 };
+    auto surface = TTF_RenderUNICODE_Blended(_font, text, SDL_Color{ 255, 255, 255, 255 });
+    if (surface == nullptr)
+    {
+      return false;
+    }
+
+    if (surface->format->format != SDL_PIXELFORMAT_ARGB8888)
+    {
+      auto converted = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_ARGB8888, 0);
+      SDL_FreeSurface(surface);
+      surface = converted;
+
+      if (surface == nullptr)
+      {
+        return false;
+      }
+    }
+
+    Rectangle source;
+    const auto page = AllocatePageSpace(surface->w, surface->h, source);
+    if (page != nullptr)
+    {
+      SDL_ASSERT_SUCCESS(SDL_UpdateTexture(page->texture, &source, surface->pixels, surface->pitch));
+      entry.texture = page->texture;
+      entry.source = source;
+    }
+
+    SDL_FreeSurface(surface);
+    return page != nullptr;
+  }
+
+  const detail::GlyphAtlasEntry& GlyphAtlas::FindGlyph(const uint16_t codePoint)
+  {
+    auto found = _glyphs.find(codePoint);
+    if (found != std::end(_glyphs))
+    {
+      return found->second;
+    }
+
+    detail::GlyphAtlasEntry entry = { nullptr, { 0, 0, 0, 0 }, 0, 0 };
+    if (!RasterizeGlyph(codePoint, entry) && codePoint != kReplacementCodePoint)
+    {
+      // Remember the failure as replacement glyph so the rasterization is not attempted every layout
+      entry = FindGlyph(kReplacementCodePoint);
+    }
+
+    return _glyphs[codePoint] = entry;
+  }
+
+  void GlyphAtlas::Layout(const std::string& text, const int32_t wrapWidth, TextLayout& layout)
+  {
+    layout.quads.clear();
+    layout.width = 0;
+    layout.height = 0;
+
+    if (text.empty())
+    {
+      return;
+    }
+
+    std::vector<uint16_t> codePoints;
+    DecodeUTF8(text, codePoints);
+
+    // Width of a line as rendered by TTF_RenderUNICODE_Blended
+    const auto measure = [&](const size_t begin, const size_t end)
+    {
+      int32_t pen = 0, right = 0;
+      for (size_t i = begin; i < end; i++)
+      {
+        const auto& glyph = FindGlyph(codePoints[i]);
+        if (i == begin)
+        {
+          pen = -glyph.offsetX;
+        }
+        else
+        {
+          pen += GetKerning(codePoints[i - 1], codePoints[i]);
+        }
+        right = std::max({ right, pen + glyph.offsetX + glyph.source.w, pen + glyph.advance });
+        pen += glyph.advance;
+      }
+      return right;
+    };
+
+    struct Line
+    {
+      size_t begin;
+      size_t end;
+    };
+    std::vector<Line> lines;
+
+    size_t lineBegin = 0;
+    size_t lastBreak = 0;
+    bool hasBreak = false;
+    for (size_t i = 0; i <= codePoints.size(); i++)
+    {
+      if (i == codePoints.size() || codePoints[i] == kNewLineCodePoint)
+      {
+        lines.push_back({ lineBegin, i });
+        lineBegin = i + 1;
+        hasBreak = false;
+        continue;
+      }
+
+      if (wrapWidth > 0 && hasBreak && measure(lineBegin, i + 1) > wrapWidth)
+      {
+        lines.push_back({ lineBegin, lastBreak });
+        lineBegin = lastBreak + 1;
+        hasBreak = false;
+      }
+
+      if (codePoints[i] == kSpaceCodePoint && i > lineBegin)
+      {
+        lastBreak = i;
+        hasBreak = true;
+      }
+    }
+
+    for (size_t lineIndex = 0; lineIndex < lines.size(); lineIndex++)
+    {
+      const auto& line = lines[lineIndex];
+      const auto y = static_cast<int32_t>(lineIndex) * _lineSkip;
+
+      int32_t pen = 0;
+      for (size_t i = line.begin; i < line.end; i++)
+      {
+        const auto& glyph = FindGlyph(codePoints[i]);
+        if (i == line.begin)
+        {
+          pen = -glyph.offsetX;
+        }
+        else
+        {
+          pen += GetKerning(codePoints[i - 1], codePoints[i]);
+        }
+
+        if (glyph.texture != nullptr)
+        {
+          layout.quads.push_back({ glyph.texture, glyph.source, { pen + glyph.offsetX, y, glyph.source.w, glyph.source.h } });
+        }
+        pen += glyph.advance;
+      }
+
+      layout.width = std::max(layout.width, measure(line.begin, line.end));
+    }
+
+    // Same dimensions as TTF_RenderUTF8_Blended_Wrapped would produce
+    if (wrapWidth > 0 && lines.size() > 1)
+    {
+      layout.width = wrapWidth;
+    }
+    layout.height = static_cast<int32_t>(lines.size() - 1) * _lineSkip + _fontHeight;
+  }
+
+  void GlyphAtlas::Render(RenderCommandBuffer& commands, const TextLayout& layout, const int32_t x, const int32_t y, const SDL_Color& color, const Rectangle* mask)
+  {
+    for (const auto& quad : layout.quads)
+    {
+      SDL_Rect destination = { quad.destination.x + x, quad.destination.y + y, quad.destination.w, quad.destination.h };
+
+      if (mask != nullptr)
+      {
+        SDL_Rect interesection;
+        if (SDL_IntersectRect(&destination, mask, &interesection) != SDL_FALSE)
+        {
+          SDL_Rect source = { quad.source.x + interesection.x - destination.x, quad.source.y + interesection.y - destination.y, interesection.w, interesection.h };
+          commands.Push(quad.texture, &source, interesection, color);
+        }
+      }
+      else
+      {
+        commands.Push(quad.texture, &quad.source, destination, color);
+      }
+    }
+  }
+}
@@ -0,0 +1,221 @@
+#include "HitMask.h"
+
+#include "EngineConstants.h"
+
+#include <algorithm>
+#include <cassert>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#define JADE_HIT_MASK_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+  static_assert(64 % JadeEngine::kHitMaskTileSize == 0, "Tiles must not straddle 64-bit words.");
+
+  int32_t LowestBit(const uint64_t word)
+  {
+    assert(word != 0);
+    int32_t bit = 0;
+    while ((word & (uint64_t(1) << bit)) == 0)
+    {
+      bit++;
+    }
+    return bit;
+  }
+
+  int32_t HighestBit(const uint64_t word)
+  {
+    assert(word != 0);
+    int32_t bit = 63;
+    while ((word & (uint64_t(1) << bit)) == 0)
+    {
+      bit--;
+    }
+    return bit;
+  }
+
+  // Opacity of 64 ARGB8888 pixels, or less at the end of a row
+  uint64_t AlphaWord(const uint32_t* pixels, const int32_t count)
+  {
+    uint64_t word = 0;
+    int32_t x = 0;
+
+#ifdef JADE_HIT_MASK_SSE2
+    const auto zero = _mm_setzero_si128();
+    for (; x + 16 <= count; x += 16)
+    {
+      // Shift alpha to the low byte and narrow 16 pixels into 16 bytes, saturation does not matter since the alphas fit in a byte
+      const auto a0 = _mm_srli_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels + x)), 24);
+      const auto a1 = _mm_srli_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels + x + 4)), 24);
+      const auto a2 = _mm_srli_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels + x + 8)), 24);
+      const auto a3 = _mm_srli_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels + x + 12)), 24);
+      const auto alphas = _mm_packus_epi16(_mm_packs_epi32(a0, a1), _mm_packs_epi32(a2, a3));
+
+      const auto transparent = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(alphas, zero)));
+      word |= static_cast<uint64_t>(~transparent & 0xFFFFU) << x;
+    }
+#endif
+
+    for (; x < count; x++)
+    {
+      if ((pixels[x] >> 24) != 0)
+      {
+        word |= uint64_t(1) << x;
+      }
+    }
+
+    return word;
+  }
+}
+
+namespace JadeEngine
+{
+  HitMask::HitMask(const int32_t width, const int32_t height)
+    : _width(width)
+    , _height(height)
+    , _wordsPerRow((width + 63) / 64)
+    , _bits(_wordsPerRow * height, 0)
+    , _tilesPerRow((width + kHitMaskTileSize - 1) / kHitMaskTileSize)
+    , _tiles(_tilesPerRow * ((height + kHitMaskTileSize - 1) / kHitMaskTileSize), kTileOccupancy_Empty)
+    , _opaqueBounds{ 0, 0, 0, 0 }
+  {
+  }
+
+  std::shared_ptr<const HitMask> HitMask::Create(SDL_Surface* surface)
+  {
+    // Alpha is always the top byte of a 32-bit pixel after the conversion which is what the row building relies on
+    auto converted = surface;
+    if (surface->format->format != SDL_PIXELFORMAT_ARGB8888)
+    {
+      converted = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_ARGB8888, 0);
+      if (converted == nullptr)
+      {
+        return nullptr;
+      }
+    }
+
+    auto mask = std::make_shared<HitMask>(converted->w, converted->h);
+
+    const auto lockedRequired = SDL_MUSTLOCK(converted);
+    if (lockedRequired)
+    {
+      SDL_LockSurface(converted);
+    }
+
+    mask->BuildRows(converted);
+
+    if (lockedRequired)
+    {
+      SDL_UnlockSurface(converted);
+    }
+
+    if (converted != surface)
+    {
+      SDL_FreeSurface(converted);
+    }
+
+    mask->BuildTiles();
+    mask->BuildOpaqueBounds();
+
+    return mask;
+  }
+
+  void HitMask::BuildRows(SDL_Surface* surface)
+  {
+    const auto pixels = reinterpret_cast<const uint8_t*>(surface->pixels);
+
+    for (int32_t y = 0; y < _height; y++)
+    {
+      const auto row = reinterpret_cast<const uint32_t*>(pixels + y * surface->pitch);
+      auto words = _bits.data() + y * _wordsPerRow;
+
+      for (size_t w = 0; w < _wordsPerRow; w++)
+      {
+        const auto x = static_cast<int32_t>(w * 64);
+        words[w] = AlphaWord(row + x, std::min(64, _width - x));
+      }
+    }
+  }
+
+  void HitMask::BuildTiles()
+  {
+    const auto tileRows = static_cast<int32_t>(_tiles.size()) / std::max(_tilesPerRow, 1);
+
+    for (int32_t ty = 0; ty < tileRows; ty++)
+    {
+      const auto yEnd = std::min(_height, (ty + 1) * kHitMaskTileSize);
+
+      for (int32_t tx = 0; tx < _tilesPerRow; tx++)
+      {
+        const auto x = tx * kHitMaskTileSize;
+        const auto word = static_cast<size_t>(x / 64);
+        const auto shift = x % 64;
+        const auto tileWidth = std::min(kHitMaskTileSize, _width - x);
+        const auto tileBits = (uint64_t(1) << tileWidth) - 1;
+
+        bool anyHit = false, allHit = true;
+        for (int32_t y = ty * kHitMaskTileSize; y < yEnd; y++)
+        {
+          const auto bits = (_bits[y * _wordsPerRow + word] >> shift) & tileBits;
+          anyHit |= bits != 0;
+          allHit &= bits == tileBits;
+        }
+
+        _tiles[ty * _tilesPerRow + tx] = allHit ? kTileOccupancy_Full : (anyHit ? kTileOccupancy_Mixed : kTileOccupancy_Empty);
+      }
+    }
+  }
+
+  void HitMask::BuildOpaqueBounds()
+  {
+    int32_t minX = _width, maxX = 0, minY = _height, maxY = 0;
+
+    for (int32_t y = 0; y < _height; y++)
+    {
+      const auto words = _bits.data() + y * _wordsPerRow;
+      const auto first = std::find_if(words, words + _wordsPerRow, [](const uint64_t word) { return word != 0; });
+      if (first == words + _wordsPerRow)
+      {
+        continue;
+      }
+
+      auto last = words + _wordsPerRow - 1;
+      while (*last == 0)
+      {
+        last--;
+      }
+
+      minX = std::min(minX, static_cast<int32_t>(first - words) * 64 + LowestBit(*first));
+      maxX = std::max(maxX, static_cast<int32_t>(last - words) * 64 + HighestBit(*last));
+      minY = std::min(minY, y);
+      maxY = std::max(maxY, y);
+    }
+
+    _opaqueBounds = { minX, minY, maxX - minX, maxY - minY };
+  }
+
+  bool HitMask::Test(const int32_t x, const int32_t y) const
+  {
+    if (x < 0 || y < 0 || x >= _width || y >= _height)
+    {
+      return false;
+    }
+
+    switch (_tiles[(y / kHitMaskTileSize) * _tilesPerRow + x / kHitMaskTileSize])
+    {
+    case kTileOccupancy_Empty:
+      return false;
+    case kTileOccupancy_Full:
+      return true;
+    default:
+      return ((_bits[y * _wordsPerRow + x / 64] >> (x % 64)) & 1) != 0;
+    }
+  }
+
+  size_t HitMask::GetMemoryUsage() const
+  {
+    return _bits.size() * sizeof(uint64_t) + _tiles.size() * sizeof(TileOccupancy);
+  }
+}
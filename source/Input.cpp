@@ -1,11 +1,11 @@
 #include "Input.h"
 
 #include "Camera.h"
-#include "Game.h"
 #include "Utils.h"
 
-#include <unordered_map>
+#include <cassert>
 #include <cctype>
+#include <unordered_map>
 
 namespace
 {
@@ -82,10 +82,21 @@ namespace JadeEngine
   Input::Input()
     : _firstKeyPressed(SDLK_UNKNOWN)
     , _mouseWheelY(0)
+    , _lastMouseX(0)
+    , _lastMouseY(0)
+    , _mouseX(0)
+    , _mouseY(0)
+    , _windowMouseX(0)
+    , _windowMouseY(0)
+    , _mouseMoved(false)
+    , _mouseInRenderCoordinates(false)
+    , _changedMouseButtons(0)
   {
+    _keyStates.fill(0);
+    _mouseButtonStates.fill(0);
+    _asciiScancodes.fill(SDL_SCANCODE_UNKNOWN);
   }
 
-
   int32_t Input::GetMouseX() const
   {
     return _mouseX;
@@ -106,119 +117,154 @@ namespace JadeEngine
     return _lastMouseY;
   }
 
+  void Input::SetMouseWindowPosition(const int32_t x, const int32_t y)
+  {
+    _windowMouseX = x;
+    _windowMouseY = y;
+    _mouseMoved = true;
+  }
+
   void Input::ProcessMessage(const SDL_Event& event)
   {
     if (event.type == SDL_KEYDOWN)
     {
-      const auto key = event.key.keysym.sym;
-      auto found = _keyStates.find(key);
-      if (found == _keyStates.end())
+      const auto scancode = event.key.keysym.scancode;
+      auto& state = _keyStates[scancode];
+
+      // Repeated key down messages of a held key are ignored
+      if ((state & kKeyStateFlag_Down) == 0)
       {
-        _keyStates[key] = kKeyState_Pressed;
+        state = static_cast<uint8_t>(state | kKeyStateFlag_Down | kKeyStateFlag_Pressed);
+        _changedKeys.push_back(scancode);
+
+        const auto key = event.key.keysym.sym;
+        _pressedKeys.push_back(key);
         if (_firstKeyPressed == SDLK_UNKNOWN)
         {
           _firstKeyPressed = key;
         }
       }
-      else
-      {
-        if (found->second == kKeyState_Pressed)
-        {
-          found->second = kKeyState_Down;
-        }
-        else if (found->second == kKeyState_Up)
-        {
-          _keyStates[key] = kKeyState_Pressed;
-          if (_firstKeyPressed == SDLK_UNKNOWN)
-          {
-            _firstKeyPressed = key;
-          }
-        }
-      }
     }
     else if (event.type == SDL_KEYUP)
     {
-      const auto key = event.key.keysym.sym;
-      _keyStates[key] = kKeyState_Up;
+      const auto scancode = event.key.keysym.scancode;
+      auto& state = _keyStates[scancode];
+      state = static_cast<uint8_t>((state & ~kKeyStateFlag_Down) | kKeyStateFlag_Released);
+      _changedKeys.push_back(scancode);
     }
     else if (event.type == SDL_MOUSEMOTION)
     {
-      SDL_GetMouseState(&_mouseX, &_mouseY);
-      _mouseX = GUICamera.WindowToRenderX(_mouseX);
-      _mouseY = GUICamera.WindowToRenderY(_mouseY);
+      SetMouseWindowPosition(event.motion.x, event.motion.y);
     }
-    else if (event.type == SDL_MOUSEBUTTONDOWN)
+    else if (event.type == SDL_MOUSEBUTTONDOWN || event.type == SDL_MOUSEBUTTONUP)
     {
-      SDL_GetMouseState(&_mouseX, &_mouseY);
-
-      _mouseX = GUICamera.WindowToRenderX(_mouseX);
-      _mouseY = GUICamera.WindowToRenderY(_mouseY);
+      SetMouseWindowPosition(event.button.x, event.button.y);
 
       const auto button = event.button.button;
-      auto found = _mouseButtonStates.find(button);
-      if (found == _mouseButtonStates.end())
-      {
-        _mouseButtonStates[button] = kKeyState_Pressed;
-      }
-      else
+      if (button < kMouseButtonSlots)
       {
-        if (found->second == kKeyState_Pressed)
+        auto& state = _mouseButtonStates[button];
+        if (event.type == SDL_MOUSEBUTTONDOWN)
         {
-          found->second = kKeyState_Down;
+          state = static_cast<uint8_t>(state | kKeyStateFlag_Down | kKeyStateFlag_Pressed);
         }
-        else if (found->second == kKeyState_Up)
+        else
         {
-          _mouseButtonStates[button] = kKeyState_Pressed;
+          state = static_cast<uint8_t>((state & ~kKeyStateFlag_Down) | kKeyStateFlag_Released);
         }
+        _changedMouseButtons = static_cast<uint8_t>(_changedMouseButtons | (1 << button));
       }
     }
-    else if (event.type == SDL_MOUSEBUTTONUP)
+    else if (event.type == SDL_MOUSEWHEEL)
     {
-      SDL_GetMouseState(&_mouseX, &_mouseY);
-
-      _mouseX = GUICamera.WindowToRenderX(_mouseX);
-      _mouseY = GUICamera.WindowToRenderY(_mouseY);
-
-      const auto button = event.button.button;
-      _mouseButtonStates[button] = kKeyState_Up;
+      _mouseWheelY = (event.wheel.direction == SDL_MOUSEWHEEL_FLIPPED) ? event.wheel.y : -event.wheel.y;
     }
-    else if (event.type == SDL_MOUSEWHEEL)
+    else if (event.type == SDL_KEYMAPCHANGED)
     {
-      SDL_GetMouseState(&_mouseX, &_mouseY);
-
-      _mouseX = GUICamera.WindowToRenderX(_mouseX);
-      _mouseY = GUICamera.WindowToRenderY(_mouseY);
+      RefreshKeymap();
+    }
+  }
 
-      _mouseWheelY = (event.wheel.direction == SDL_MOUSEWHEEL_FLIPPED) ? event.wheel.y : -event.wheel.y;
+  void Input::AfterMessages()
+  {
+    // A burst of motion messages only needs its final position converted
+    if (_mouseMoved)
+    {
+      _mouseMoved = false;
+      _mouseX = _mouseInRenderCoordinates ? _windowMouseX : GUICamera.WindowToRenderX(_windowMouseX);
+      _mouseY = _mouseInRenderCoordinates ? _windowMouseY : GUICamera.WindowToRenderY(_windowMouseY);
     }
   }
 
-  bool Input::KeyDown(SDL_Keycode key)
+  void Input::RefreshKeymap()
   {
-    auto found = _keyStates.find(key);
-    if (found == _keyStates.end())
+    for (SDL_Keycode key = 0; key < static_cast<SDL_Keycode>(kAsciiKeycodes); key++)
     {
-      _keyStates[key] = kKeyState_Up;
-      return false;
+      _asciiScancodes[key] = SDL_GetScancodeFromKey(key);
     }
-    else
+
+    for (size_t keybind = 0; keybind < _keybindKeys.size(); keybind++)
     {
-      return found->second > kKeyState_Up;
+      _keybindScancodes[keybind] = ToScancode(_keybindKeys[keybind]);
     }
   }
 
-  bool Input::KeyPressed(SDL_Keycode key)
+  void Input::SetKeybind(const int32_t keybind, const SDL_Keycode key)
   {
-    auto found = _keyStates.find(key);
-    if (found == _keyStates.end())
+    assert(keybind >= 0);
+    if (static_cast<size_t>(keybind) >= _keybindKeys.size())
     {
-      _keyStates[key] = kKeyState_Up;
-      return false;
+      _keybindKeys.resize(keybind + 1, SDLK_UNKNOWN);
+      _keybindScancodes.resize(keybind + 1, SDL_SCANCODE_UNKNOWN);
     }
-    else
+
+    _keybindKeys[keybind] = key;
+    _keybindScancodes[keybind] = ToScancode(key);
+  }
+
+  SDL_Scancode Input::ToScancode(const SDL_Keycode key) const
+  {
+    // Keys without a character, such as arrows, encode their scancode directly
+    if ((key & SDLK_SCANCODE_MASK) != 0)
     {
-      return found->second == kKeyState_Pressed;
+      return static_cast<SDL_Scancode>(key & ~SDLK_SCANCODE_MASK);
     }
+    else if (key >= 0 && key < static_cast<SDL_Keycode>(kAsciiKeycodes))
+    {
+      return _asciiScancodes[key];
+    }
+
+    return SDL_GetScancodeFromKey(key);
+  }
+
+  uint8_t Input::ScancodeState(const SDL_Scancode scancode) const
+  {
+    return scancode > SDL_SCANCODE_UNKNOWN && scancode < SDL_NUM_SCANCODES ? _keyStates[scancode] : 0;
+  }
+
+  uint8_t Input::KeybindState(const int32_t keybind) const
+  {
+    return keybind >= 0 && static_cast<size_t>(keybind) < _keybindScancodes.size() ? ScancodeState(_keybindScancodes[keybind]) : 0;
+  }
+
+  uint8_t Input::MouseButtonState(const int32_t button) const
+  {
+    return button >= 0 && static_cast<size_t>(button) < kMouseButtonSlots ? _mouseButtonStates[button] : 0;
+  }
+
+  bool Input::KeyDown(SDL_Keycode key) const
+  {
+    return (ScancodeState(ToScancode(key)) & kKeyStateFlag_Down) != 0;
+  }
+
+  bool Input::KeyPressed(SDL_Keycode key) const
+  {
+    return (ScancodeState(ToScancode(key)) & kKeyStateFlag_Pressed) != 0;
+  }
+
+  bool Input::KeyReleased(SDL_Keycode key) const
+  {
+    return (ScancodeState(ToScancode(key)) & kKeyStateFlag_Released) != 0;
   }
 
   SDL_Keycode Input::FirstKeyPressed() const
@@ -226,56 +272,42 @@ namespace JadeEngine
     return _firstKeyPressed;
   }
 
-  bool Input::MouseButtonDown(int32_t key)
+  bool Input::MouseButtonDown(int32_t key) const
   {
-    auto found = _mouseButtonStates.find(key);
-    if (found == _mouseButtonStates.end())
-    {
-      _mouseButtonStates[key] = kKeyState_Up;
-      return false;
-    }
-    else
-    {
-      return found->second > kKeyState_Up;
-    }
+    return (MouseButtonState(key) & kKeyStateFlag_Down) != 0;
   }
 
-  bool Input::MouseButtonPressed(int32_t key)
+  bool Input::MouseButtonPressed(int32_t key) const
   {
-    auto found = _mouseButtonStates.find(key);
-    if (found == _mouseButtonStates.end())
-    {
-      _mouseButtonStates[key] = kKeyState_Up;
-      return false;
-    }
-    else
-    {
-      return found->second == kKeyState_Pressed;
-    }
+    return (MouseButtonState(key) & kKeyStateFlag_Pressed) != 0;
+  }
+
+  bool Input::MouseButtonReleased(int32_t key) const
+  {
+    return (MouseButtonState(key) & kKeyStateFlag_Released) != 0;
   }
 
   void Input::Update()
   {
     _firstKeyPressed = SDLK_UNKNOWN;
+    _pressedKeys.clear();
     _lastMouseX = _mouseX;
     _lastMouseY = _mouseY;
   }
 
   void Input::AfterUpdate()
   {
-    for (auto& keyState : _keyStates)
+    for (const auto scancode : _changedKeys)
     {
-      if (keyState.second == kKeyState_Pressed)
-      {
-        keyState.second = kKeyState_Down;
-      }
+      _keyStates[scancode] &= kKeyStateFlag_Down;
     }
+    _changedKeys.clear();
 
-    for (auto& buttonState : _mouseButtonStates)
+    for (size_t button = 0; _changedMouseButtons != 0; button++, _changedMouseButtons >>= 1)
     {
-      if (buttonState.second == kKeyState_Pressed)
+      if ((_changedMouseButtons & 1) != 0)
       {
-        buttonState.second = kKeyState_Down;
+        _mouseButtonStates[button] &= kKeyStateFlag_Down;
       }
     }
 
@@ -293,15 +325,13 @@ namespace JadeEngine
     return std::string(1, std::toupper(key));
   }
 
-  bool Input::KeybindDown(const int32_t keybind)
+  bool Input::KeybindDown(const int32_t keybind) const
   {
-    const auto key = GGame.GeyKeyFromKeybind(keybind);
-    return key != SDLK_UNKNOWN ? KeyDown(key) : false;
+    return (KeybindState(keybind) & kKeyStateFlag_Down) != 0;
   }
 
-  bool Input::KeybindPressed(const int32_t keybind)
+  bool Input::KeybindPressed(const int32_t keybind) const
   {
-    const auto key = GGame.GeyKeyFromKeybind(keybind);
-    return key != SDLK_UNKNOWN ? KeyPressed(key) : false;
+    return (KeybindState(keybind) & kKeyStateFlag_Pressed) != 0;
   }
-}
\ No newline at end of file
+}
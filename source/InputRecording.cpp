@@ -0,0 +1,245 @@
+#include "InputRecording.h"
+
+#include "Camera.h"
+
+#include <cstring>
+
+namespace
+{
+  const char kRecordingMagic[4] = { 'J', 'I', 'R', 'F' };
+  // Version 2 stores mouse positions in render coordinates
+  const uint32_t kRecordingVersion = 2;
+
+  enum RecordedEvent : uint8_t
+  {
+    kRecordedEvent_Quit,
+    kRecordedEvent_KeyDown,
+    kRecordedEvent_KeyUp,
+    kRecordedEvent_MouseMotion,
+    kRecordedEvent_MouseButtonDown,
+    kRecordedEvent_MouseButtonUp,
+    kRecordedEvent_MouseWheel,
+    kRecordedEvent_KeymapChanged,
+  };
+
+  template<typename T>
+  void Put(std::vector<uint8_t>& buffer, const T value)
+  {
+    const auto offset = buffer.size();
+    buffer.resize(offset + sizeof(T));
+    std::memcpy(buffer.data() + offset, &value, sizeof(T));
+  }
+
+  template<typename T>
+  bool Get(std::ifstream& file, T& value)
+  {
+    return static_cast<bool>(file.read(reinterpret_cast<char*>(&value), sizeof(T)));
+  }
+
+  template<typename Stored, typename T>
+  bool GetAs(std::ifstream& file, T& value)
+  {
+    Stored stored;
+    if (!Get(file, stored))
+    {
+      return false;
+    }
+
+    value = static_cast<T>(stored);
+    return true;
+  }
+}
+
+namespace JadeEngine
+{
+  InputRecorder::InputRecorder()
+    : _frameEvents(0)
+  {
+  }
+
+  bool InputRecorder::Open(const std::string& path, const uint32_t seed, const int32_t width, const int32_t height)
+  {
+    _file.open(path, std::ios::binary | std::ios::trunc);
+    if (!_file.is_open())
+    {
+      return false;
+    }
+
+    std::vector<uint8_t> header;
+    header.insert(std::end(header), std::begin(kRecordingMagic), std::end(kRecordingMagic));
+    Put(header, kRecordingVersion);
+    Put(header, seed);
+    Put(header, width);
+    Put(header, height);
+    _file.write(reinterpret_cast<const char*>(header.data()), header.size());
+
+    return static_cast<bool>(_file);
+  }
+
+  void InputRecorder::BeginFrame(const float deltaTime)
+  {
+    _frame.clear();
+    _frameEvents = 0;
+    Put(_frame, deltaTime);
+    // Patched with the final count once the frame ends
+    Put(_frame, _frameEvents);
+  }
+
+  void InputRecorder::Record(const SDL_Event& event)
+  {
+    if (_frameEvents == UINT16_MAX)
+    {
+      return;
+    }
+
+    switch (event.type)
+    {
+    case SDL_QUIT:
+      Put(_frame, kRecordedEvent_Quit);
+      break;
+    case SDL_KEYDOWN:
+    case SDL_KEYUP:
+      Put(_frame, event.type == SDL_KEYDOWN ? kRecordedEvent_KeyDown : kRecordedEvent_KeyUp);
+      Put(_frame, static_cast<int32_t>(event.key.keysym.sym));
+      Put(_frame, static_cast<uint16_t>(event.key.keysym.scancode));
+      Put(_frame, static_cast<uint16_t>(event.key.keysym.mod));
+      Put(_frame, static_cast<uint8_t>(event.key.repeat));
+      break;
+    case SDL_MOUSEMOTION:
+      Put(_frame, kRecordedEvent_MouseMotion);
+      Put(_frame, GUICamera.WindowToRenderX(event.motion.x));
+      Put(_frame, GUICamera.WindowToRenderY(event.motion.y));
+      break;
+    case SDL_MOUSEBUTTONDOWN:
+    case SDL_MOUSEBUTTONUP:
+      Put(_frame, event.type == SDL_MOUSEBUTTONDOWN ? kRecordedEvent_MouseButtonDown : kRecordedEvent_MouseButtonUp);
+      Put(_frame, event.button.button);
+      Put(_frame, event.button.clicks);
+      Put(_frame, GUICamera.WindowToRenderX(event.button.x));
+      Put(_frame, GUICamera.WindowToRenderY(event.button.y));
+      break;
+    case SDL_MOUSEWHEEL:
+      Put(_frame, kRecordedEvent_MouseWheel);
+      Put(_frame, event.wheel.x);
+      Put(_frame, event.wheel.y);
+      Put(_frame, static_cast<uint8_t>(event.wheel.direction));
+      break;
+    case SDL_KEYMAPCHANGED:
+      Put(_frame, kRecordedEvent_KeymapChanged);
+      break;
+    default:
+      return;
+    }
+
+    _frameEvents++;
+  }
+
+  void InputRecorder::EndFrame()
+  {
+    std::memcpy(_frame.data() + sizeof(float), &_frameEvents, sizeof(_frameEvents));
+    _file.write(reinterpret_cast<const char*>(_frame.data()), _frame.size());
+  }
+
+  InputReplay::InputReplay()
+    : _seed(0)
+  {
+  }
+
+  bool InputReplay::Open(const std::string& path, const int32_t width, const int32_t height)
+  {
+    _file.open(path, std::ios::binary);
+    if (!_file.is_open())
+    {
+      return false;
+    }
+
+    char magic[sizeof(kRecordingMagic)];
+    uint32_t version;
+    int32_t recordedWidth;
+    int32_t recordedHeight;
+    const auto valid = _file.read(magic, sizeof(magic))
+      && std::memcmp(magic, kRecordingMagic, sizeof(magic)) == 0
+      && Get(_file, version) && version == kRecordingVersion
+      && Get(_file, _seed)
+      && Get(_file, recordedWidth) && Get(_file, recordedHeight)
+      // Mouse positions are stored in render coordinates of the recorded resolution
+      && recordedWidth == width && recordedHeight == height;
+
+    if (!valid)
+    {
+      _file.close();
+    }
+
+    return valid;
+  }
+
+  bool InputReplay::NextFrame(float& deltaTime, std::vector<SDL_Event>& events)
+  {
+    events.clear();
+
+    uint16_t count;
+    if (!Get(_file, deltaTime) || !Get(_file, count))
+    {
+      return false;
+    }
+
+    for (uint16_t i = 0; i < count; i++)
+    {
+      RecordedEvent kind;
+      if (!Get(_file, kind))
+      {
+        return false;
+      }
+
+      SDL_Event event;
+      std::memset(&event, 0, sizeof(event));
+      auto valid = true;
+
+      switch (kind)
+      {
+      case kRecordedEvent_Quit:
+        event.type = SDL_QUIT;
+        break;
+      case kRecordedEvent_KeyDown:
+      case kRecordedEvent_KeyUp:
+        event.type = kind == kRecordedEvent_KeyDown ? SDL_KEYDOWN : SDL_KEYUP;
+        event.key.state = kind == kRecordedEvent_KeyDown ? SDL_PRESSED : SDL_RELEASED;
+        valid = GetAs<int32_t>(_file, event.key.keysym.sym)
+          && GetAs<uint16_t>(_file, event.key.keysym.scancode)
+          && GetAs<uint16_t>(_file, event.key.keysym.mod)
+          && Get(_file, event.key.repeat);
+        break;
+      case kRecordedEvent_MouseMotion:
+        event.type = SDL_MOUSEMOTION;
+        valid = Get(_file, event.motion.x) && Get(_file, event.motion.y);
+        break;
+      case kRecordedEvent_MouseButtonDown:
+      case kRecordedEvent_MouseButtonUp:
+        event.type = kind == kRecordedEvent_MouseButtonDown ? SDL_MOUSEBUTTONDOWN : SDL_MOUSEBUTTONUP;
+        event.button.state = kind == kRecordedEvent_MouseButtonDown ? SDL_PRESSED : SDL_RELEASED;
+        valid = Get(_file, event.button.button) && Get(_file, event.button.clicks)
+          && Get(_file, event.button.x) && Get(_file, event.button.y);
+        break;
+      case kRecordedEvent_MouseWheel:
+        event.type = SDL_MOUSEWHEEL;
+        valid = Get(_file, event.wheel.x) && Get(_file, event.wheel.y) && GetAs<uint8_t>(_file, event.wheel.direction);
+        break;
+      case kRecordedEvent_KeymapChanged:
+        event.type = SDL_KEYMAPCHANGED;
+        break;
+      default:
+        valid = false;
+        break;
+      }
+
+      if (!valid)
+      {
+        return false;
+      }
+
+      events.push_back(event);
+    }
+
+    return true;
+  }
+}
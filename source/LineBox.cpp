@@ -19,6 +19,10 @@ namespace JadeEngine
     UpdatePoints();
     transform->Attach(_strip->transform, kZeroVector2D_i32, kAnchor_Center, kAnchor_Center);
 
+    // Points only change with the size
+    SetUpdatePolicy(kUpdatePolicy_OnWake);
+    SetWakeEvents(kWakeEvent_TransformDirty);
+
     Show(true);
   }
 
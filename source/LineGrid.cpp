@@ -27,6 +27,7 @@ namespace JadeEngine
       _strips[i] = GGame.Create<LineStrip>(stripParams);
     }
     SetPosition(0, 0);
+    SetUpdatePolicy(kUpdatePolicy_Never);
   }
 
   void LineGrid::Update()
@@ -14,6 +14,10 @@ namespace JadeEngine
     transform->Initialize(0, 0, 0, 0);
     _z = params.z;
     SetPoints(params.initialPoints);
+
+    // Points only change when the strip is moved
+    SetUpdatePolicy(kUpdatePolicy_OnWake);
+    SetWakeEvents(kWakeEvent_TransformDirty);
   }
 
 
@@ -36,6 +40,23 @@ namespace JadeEngine
     }
   }
 
+  Rectangle LineStrip::GetRenderBounds() const
+  {
+    Rectangle bounds = { 0, 0, 0, 0 };
+    if (!_points.empty())
+    {
+      SDL_EnclosePoints(_points.data(), static_cast<int32_t>(_points.size()), nullptr, &bounds);
+    }
+
+    if (_layer == kObjectLayer_World)
+    {
+      bounds.x -= GWorldCamera.GetX();
+      bounds.y -= GWorldCamera.GetY();
+    }
+
+    return bounds;
+  }
+
   void LineStrip::UpdatePoints()
   {
     _points.clear();
@@ -45,6 +66,7 @@ namespace JadeEngine
       const auto position = centerPosition + point;
       return SDL_Point{ position.x, position.y };
     });
+    Invalidate();
   }
 
   void LineStrip::SetPoints(const std::vector<Vector2D_i32>& points)
@@ -71,6 +71,12 @@ namespace JadeEngine
     buttonParams.height = 50;
     _quitButton = GGame.Create<Button>(buttonParams);
 
+    // The buttons only change when hovered or pressed, drawing each from a texture saves most of the menu's draw calls
+    for (const auto button : { _playButton, _optionsButton, _quitButton })
+    {
+      GGame.SetCachedAsTexture(button, true);
+    }
+
     TransformGroupParams groupParams;
     groupParams.layer = kObjectLayer_UI;
     groupParams.spacing = 30;
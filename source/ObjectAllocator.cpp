@@ -0,0 +1,194 @@
+#include "ObjectAllocator.h"
+
+#include "EngineConstants.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <new>
+
+namespace
+{
+  // Alignment of memory returned by new[], no %game object needs more
+  const size_t kBlockAlignment = alignof(std::max_align_t);
+
+  size_t AlignUp(const size_t value, const size_t alignment)
+  {
+    return (value + alignment - 1) & ~(alignment - 1);
+  }
+
+  void*& NextFree(void* memory)
+  {
+    return *static_cast<void**>(memory);
+  }
+}
+
+namespace JadeEngine
+{
+  namespace detail
+  {
+    uint32_t RegisterObjectType()
+    {
+      static std::atomic<uint32_t> nextId(0);
+      return nextId++;
+    }
+
+    ObjectAllocationCounters::ObjectAllocationCounters()
+      : _allocations(0)
+      , _deallocations(0)
+    {
+    }
+
+    void ObjectAllocationCounters::OnAllocate(const ObjectTypeInfo& type, const bool reused)
+    {
+      if (type.id >= _types.size())
+      {
+        _types.resize(type.id + 1, { nullptr, 0, 0, 0, 0, 0 });
+      }
+
+      auto& stats = _types[type.id];
+      stats.name = type.name;
+      stats.objectSize = type.size;
+      stats.liveObjects++;
+      stats.peakObjects = std::max(stats.peakObjects, stats.liveObjects);
+      stats.allocations++;
+      if (reused)
+      {
+        stats.reusedAllocations++;
+      }
+
+      _allocations++;
+    }
+
+    void ObjectAllocationCounters::OnDeallocate(const ObjectTypeInfo& type)
+    {
+      assert(type.id < _types.size() && _types[type.id].liveObjects > 0);
+      _types[type.id].liveObjects--;
+      _deallocations++;
+    }
+
+    void ObjectAllocationCounters::Fill(ObjectAllocatorStats& stats) const
+    {
+      stats.allocations = _allocations;
+      stats.deallocations = _deallocations;
+      stats.liveObjects = static_cast<uint32_t>(_allocations - _deallocations);
+      stats.types = _types;
+    }
+  }
+
+  void* PoolObjectAllocator::Allocate(const size_t arenaIndex, const ObjectTypeInfo& type)
+  {
+    assert(type.alignment <= kBlockAlignment);
+
+    if (arenaIndex >= _arenas.size())
+    {
+      _arenas.resize(arenaIndex + 1);
+    }
+
+    auto& arena = _arenas[arenaIndex];
+    if (type.id >= arena.pools.size())
+    {
+      arena.pools.resize(type.id + 1);
+    }
+
+    arena.liveObjects++;
+
+    auto& pool = arena.pools[type.id];
+    if (pool.freeList != nullptr)
+    {
+      const auto result = pool.freeList;
+      pool.freeList = NextFree(result);
+      _counters.OnAllocate(type, true);
+      return result;
+    }
+
+    _counters.OnAllocate(type, false);
+    return AllocateFromBlocks(arena, pool, type);
+  }
+
+  void* PoolObjectAllocator::AllocateFromBlocks(detail::ObjectArena& arena, detail::ObjectPool& pool, const ObjectTypeInfo& type)
+  {
+    const auto size = AlignUp(type.size, kBlockAlignment);
+    arena.usedBytes += size;
+
+    if (pool.blocks.empty() || pool.blockUsed + size > pool.blockSize)
+    {
+      // Classes with only a few objects in the scene do not reserve a whole block
+      pool.blockSize = pool.blocks.empty() ? size * kObjectPoolFirstBlockObjects : pool.blockSize * 2;
+      pool.blockSize = std::max(size, std::min(pool.blockSize, static_cast<size_t>(kObjectArenaBlockSize)));
+
+      pool.blocks.push_back(std::make_unique<uint8_t[]>(pool.blockSize));
+      arena.reservedBytes += pool.blockSize;
+      pool.blockUsed = 0;
+    }
+
+    const auto result = pool.blocks.back().get() + pool.blockUsed;
+    pool.blockUsed += size;
+    return result;
+  }
+
+  void PoolObjectAllocator::Deallocate(const size_t arenaIndex, const ObjectTypeInfo& type, void* memory)
+  {
+    assert(arenaIndex < _arenas.size());
+    auto& arena = _arenas[arenaIndex];
+
+    assert(arena.liveObjects > 0);
+    arena.liveObjects--;
+
+    auto& pool = arena.pools[type.id];
+    NextFree(memory) = pool.freeList;
+    pool.freeList = memory;
+
+    _counters.OnDeallocate(type);
+  }
+
+  void PoolObjectAllocator::ResetArena(const size_t arenaIndex)
+  {
+    if (arenaIndex < _arenas.size())
+    {
+      assert(_arenas[arenaIndex].liveObjects == 0);
+      _arenas[arenaIndex] = detail::ObjectArena();
+    }
+  }
+
+  ObjectAllocatorStats PoolObjectAllocator::GetStats() const
+  {
+    ObjectAllocatorStats stats = {};
+    for (const auto& arena : _arenas)
+    {
+      stats.reservedBytes += arena.reservedBytes;
+      stats.usedBytes += arena.usedBytes;
+    }
+
+    _counters.Fill(stats);
+    return stats;
+  }
+
+  HeapObjectAllocator::HeapObjectAllocator()
+    : _usedBytes(0)
+  {
+  }
+
+  void* HeapObjectAllocator::Allocate(const size_t arena, const ObjectTypeInfo& type)
+  {
+    _usedBytes += type.size;
+    _counters.OnAllocate(type, false);
+    return ::operator new(type.size);
+  }
+
+  void HeapObjectAllocator::Deallocate(const size_t arena, const ObjectTypeInfo& type, void* memory)
+  {
+    _usedBytes -= type.size;
+    _counters.OnDeallocate(type);
+    ::operator delete(memory);
+  }
+
+  ObjectAllocatorStats HeapObjectAllocator::GetStats() const
+  {
+    ObjectAllocatorStats stats = {};
+    stats.reservedBytes = _usedBytes;
+    stats.usedBytes = _usedBytes;
+    _counters.Fill(stats);
+    return stats;
+  }
+}
@@ -59,6 +59,11 @@ namespace JadeEngine
     _sectionTitles[2]->transform->SetCenterPosition(GGame.GetHalfWidth() + 170,
       GGame.GetHalfHeight() - _passiveSectionY);
 
+    for (const auto sectionTitle : _sectionTitles)
+    {
+      GGame.SetCachedAsTexture(sectionTitle, true);
+    }
+
     auto sliderParams = kOptionsSlider;
     sliderParams.initialValue = GAudio.GetMusicVolume();
     _musicVolume = GGame.Create<Slider>(sliderParams);
@@ -84,6 +89,7 @@ namespace JadeEngine
     buttonParams.text = "BACK";
     _backButton = GGame.Create<Button>(buttonParams);
     _backButton->transform->SetCenterPosition(GGame.GetHalfWidth(), GGame.GetHeight() - 100);
+    GGame.SetCachedAsTexture(_backButton, true);
 
     std::ostringstream descrStr;
 
@@ -99,6 +105,7 @@ namespace JadeEngine
       buttonParams.text = key;
       auto button = GGame.Create<Button>(buttonParams);
       button->Show(false);
+      GGame.SetCachedAsTexture(button, true);
       _keybindingButtons.push_back(button);
 
       textParams.text = keybinding.second.uiDescription;
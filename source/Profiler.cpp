@@ -0,0 +1,139 @@
+#include "Profiler.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace
+{
+  const char* kProfilerPhaseNames[JadeEngine::kProfilerPhase_Count] =
+  {
+    "Destroy", // kProfilerPhase_Destroy
+    "Load", // kProfilerPhase_Load
+    "Hover", // kProfilerPhase_Hover
+    "Update", // kProfilerPhase_UpdateGameObjects
+    "Scene", // kProfilerPhase_SceneUpdate
+    "Transforms", // kProfilerPhase_UpdateTransforms
+    "Render", // kProfilerPhase_Render
+    "Present", // kProfilerPhase_Present
+  };
+}
+
+namespace JadeEngine
+{
+  Profiler GProfiler;
+
+  Profiler::Profiler()
+    : _finishedFrames(0)
+    , _currentFrame{}
+  {
+    for (auto& slot : _history)
+    {
+      slot.frameIndex.store(0, std::memory_order_relaxed);
+      slot.frameTime.store(0.0f, std::memory_order_relaxed);
+      for (auto& phaseTime : slot.phaseTimes)
+      {
+        phaseTime.store(0.0f, std::memory_order_relaxed);
+      }
+    }
+  }
+
+  void Profiler::BeginFrame()
+  {
+    _currentFrame.frameIndex = _finishedFrames.load(std::memory_order_relaxed);
+    _currentFrame.frameTime = 0.0f;
+    _currentFrame.phaseTimes.fill(0.0f);
+    _frameStart = std::chrono::steady_clock::now();
+  }
+
+  void Profiler::EndFrame()
+  {
+    _currentFrame.frameTime = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - _frameStart).count();
+
+    auto& slot = _history[_currentFrame.frameIndex % kProfilerHistorySize];
+    slot.frameIndex.store(_currentFrame.frameIndex, std::memory_order_relaxed);
+    slot.frameTime.store(_currentFrame.frameTime, std::memory_order_relaxed);
+    for (size_t i = 0; i < kProfilerPhase_Count; i++)
+    {
+      slot.phaseTimes[i].store(_currentFrame.phaseTimes[i], std::memory_order_relaxed);
+    }
+
+    // Publish the slot, readers acquire this counter before touching the slot
+    _finishedFrames.store(_currentFrame.frameIndex + 1, std::memory_order_release);
+  }
+
+  void Profiler::AddPhaseTime(const ProfilerPhase phase, const float milliseconds)
+  {
+    assert(phase < kProfilerPhase_Count);
+    _currentFrame.phaseTimes[phase] += milliseconds;
+  }
+
+  bool Profiler::GetFrame(const size_t framesAgo, ProfilerFrame& frame) const
+  {
+    const auto finishedFrames = _finishedFrames.load(std::memory_order_acquire);
+    if (framesAgo >= std::min<uint64_t>(finishedFrames, kProfilerHistorySize))
+    {
+      return false;
+    }
+
+    const auto frameIndex = finishedFrames - 1 - framesAgo;
+    const auto& slot = _history[frameIndex % kProfilerHistorySize];
+
+    frame.frameIndex = slot.frameIndex.load(std::memory_order_relaxed);
+    frame.frameTime = slot.frameTime.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < kProfilerPhase_Count; i++)
+    {
+      frame.phaseTimes[i] = slot.phaseTimes[i].load(std::memory_order_relaxed);
+    }
+
+    // The game loop might have lapped us and started overwriting the slot while we were reading it
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const auto finishedFramesAfter = _finishedFrames.load(std::memory_order_relaxed);
+    return frame.frameIndex == frameIndex && finishedFramesAfter - frameIndex < kProfilerHistorySize;
+  }
+
+  ProfilerFrame Profiler::GetAverage(const size_t frames) const
+  {
+    ProfilerFrame result = {};
+    size_t count = 0;
+
+    ProfilerFrame frame;
+    for (size_t i = 0; i < frames && GetFrame(i, frame); i++)
+    {
+      result.frameIndex = std::max(result.frameIndex, frame.frameIndex);
+      result.frameTime += frame.frameTime;
+      for (size_t phase = 0; phase < kProfilerPhase_Count; phase++)
+      {
+        result.phaseTimes[phase] += frame.phaseTimes[phase];
+      }
+      count++;
+    }
+
+    if (count > 0)
+    {
+      result.frameTime /= count;
+      for (auto& phaseTime : result.phaseTimes)
+      {
+        phaseTime /= count;
+      }
+    }
+
+    return result;
+  }
+
+  const char* Profiler::GetPhaseName(const ProfilerPhase phase)
+  {
+    assert(phase < kProfilerPhase_Count);
+    return kProfilerPhaseNames[phase];
+  }
+
+  ScopedProfilerPhase::ScopedProfilerPhase(const ProfilerPhase phase)
+    : _phase(phase)
+    , _start(std::chrono::steady_clock::now())
+  {
+  }
+
+  ScopedProfilerPhase::~ScopedProfilerPhase()
+  {
+    GProfiler.AddPhaseTime(_phase, std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - _start).count());
+  }
+}
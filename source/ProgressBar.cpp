@@ -114,6 +114,11 @@ namespace JadeEngine
         _displayedValue = MoveTowards(_displayedValue, _currentValue,
           _valueUpdateSpeed * GTime.deltaTime);
         SetT(_displayedValue / _maxValue);
+
+        if (_displayedValue != _currentValue)
+        {
+          Wake();
+        }
     }
   }
   int32_t ProgressBar::GetHeight() const
@@ -170,6 +175,9 @@ namespace JadeEngine
 
     SetPosition(_backgroundLeft->transform->GetX(), _backgroundLeft->transform->GetY());
     UpdateForegroundsVisibility();
+
+    // Only animates towards a changed value
+    SetUpdatePolicy(kUpdatePolicy_OnWake);
   }
 
   void ProgressBar::InitValue(float maxValue, float initValue)
@@ -192,5 +200,9 @@ namespace JadeEngine
     {
       _displayedValue = _currentValue;
     }
+    else
+    {
+      Wake();
+    }
   }
 }
\ No newline at end of file
@@ -0,0 +1,82 @@
+#include "RenderCache.h"
+
+#include <algorithm>
+
+namespace
+{
+  const int32_t kRenderTargetGranularity = 64;
+
+  int32_t RoundUpSize(const int32_t size)
+  {
+    return (size + kRenderTargetGranularity - 1) / kRenderTargetGranularity * kRenderTargetGranularity;
+  }
+}
+
+namespace JadeEngine
+{
+  RenderTargetPool::RenderTargetPool()
+    : _blendMode(SDL_ComposeCustomBlendMode(SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD,
+      SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD))
+  {
+  }
+
+  SDL_Texture* RenderTargetPool::Acquire(SDL_Renderer* renderer, const uint32_t format, const int32_t width, const int32_t height)
+  {
+    // The smallest released texture that fits wastes the least memory
+    auto best = std::end(_released);
+    int32_t bestArea = INT32_MAX;
+    for (auto it = std::begin(_released); it != std::end(_released); ++it)
+    {
+      int32_t textureWidth;
+      int32_t textureHeight;
+      SDL_QueryTexture(*it, nullptr, nullptr, &textureWidth, &textureHeight);
+      if (textureWidth >= width && textureHeight >= height && textureWidth * textureHeight < bestArea)
+      {
+        best = it;
+        bestArea = textureWidth * textureHeight;
+      }
+    }
+
+    if (best != std::end(_released))
+    {
+      const auto texture = *best;
+      _released.erase(best);
+      return texture;
+    }
+
+    const auto texture = SDL_CreateTexture(renderer, format, SDL_TEXTUREACCESS_TARGET, RoundUpSize(width), RoundUpSize(height));
+    if (texture == nullptr)
+    {
+      return nullptr;
+    }
+
+    // Rendering into a transparent target with ordinary blending leaves the colors multiplied by alpha,
+    // drawing them with ordinary blending again would darken the edges of anything translucent
+    if (SDL_SetTextureBlendMode(texture, _blendMode) != 0)
+    {
+      SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+    }
+
+    _textures.push_back(texture);
+    return texture;
+  }
+
+  void RenderTargetPool::Release(SDL_Texture* texture)
+  {
+    if (texture != nullptr)
+    {
+      _released.push_back(texture);
+    }
+  }
+
+  void RenderTargetPool::Clear()
+  {
+    for (const auto texture : _textures)
+    {
+      SDL_DestroyTexture(texture);
+    }
+
+    _textures.clear();
+    _released.clear();
+  }
+}
@@ -0,0 +1,325 @@
+#include "RenderCommandBuffer.h"
+
+#include "Utils.h"
+
+#include <cassert>
+#include <cmath>
+
+namespace
+{
+  // How many batches back a command may travel to join a batch with the same texture
+  const size_t kMaxBatchLookback = 16;
+
+  bool IsNeutralColorMod(const SDL_Color& colorMod)
+  {
+    return colorMod.r == 255 && colorMod.g == 255 && colorMod.b == 255 && colorMod.a == 255;
+  }
+
+  bool IsSameColorMod(const SDL_Color& a, const SDL_Color& b)
+  {
+    return a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a;
+  }
+
+  bool IsSameRectangle(const JadeEngine::Rectangle& a, const JadeEngine::Rectangle& b)
+  {
+    return a.x == b.x && a.y == b.y && a.w == b.w && a.h == b.h;
+  }
+
+  JadeEngine::Rectangle CommandBounds(const JadeEngine::RenderCommand& command)
+  {
+    if (!command.rotated)
+    {
+      return command.destination;
+    }
+
+    // Rotation is around the center, the rotated rectangle always fits into the circle around it
+    const auto& destination = command.destination;
+    const auto radius = static_cast<int32_t>(std::ceil(std::sqrt(static_cast<double>(destination.w) * destination.w
+      + static_cast<double>(destination.h) * destination.h) / 2.0));
+    const auto centerX = destination.x + destination.w / 2;
+    const auto centerY = destination.y + destination.h / 2;
+    return { centerX - radius, centerY - radius, 2 * radius + 1, 2 * radius + 1 };
+  }
+
+  JadeEngine::Rectangle Union(const JadeEngine::Rectangle& a, const JadeEngine::Rectangle& b)
+  {
+    JadeEngine::Rectangle result;
+    SDL_UnionRect(&a, &b, &result);
+    return result;
+  }
+}
+
+namespace JadeEngine
+{
+  RenderCommandBuffer::RenderCommandBuffer()
+    : _usedBatches(0)
+    , _target{ 0, 0, 0, 0 }
+    , _currentZ(0)
+    , _clipped(false)
+    , _clip{ 0, 0, 0, 0 }
+    , _offset{ 0, 0 }
+    , _frameStats{}
+    , _lastFrameStats{}
+    , _lastPushedTexture(nullptr)
+    , _lastDrawnTexture(nullptr)
+  {
+  }
+
+  void RenderCommandBuffer::BeginFrame(const int32_t targetWidth, const int32_t targetHeight)
+  {
+    assert(_commands.empty());
+
+    _target = { 0, 0, targetWidth, targetHeight };
+    _frameStats = {};
+    _lastPushedTexture = nullptr;
+    _lastDrawnTexture = nullptr;
+    _clipped = false;
+  }
+
+  void RenderCommandBuffer::EndFrame(SDL_Renderer* renderer)
+  {
+    Flush(renderer);
+    _lastFrameStats = _frameStats;
+  }
+
+  void RenderCommandBuffer::SetClip(const Rectangle* clip)
+  {
+    _clipped = clip != nullptr;
+    if (_clipped)
+    {
+      _clip = *clip;
+    }
+  }
+
+  void RenderCommandBuffer::Push(SDL_Texture* texture, const Rectangle* source, const Rectangle& destination, const SDL_Color& colorMod, const double angle)
+  {
+    RenderCommand command;
+    command.texture = texture;
+    command.destination = destination;
+    command.angle = angle;
+    command.rotated = angle != 0.0;
+    command.colorMod = colorMod;
+    command.clipped = false;
+
+    if (source != nullptr)
+    {
+      command.source = *source;
+    }
+    else
+    {
+      command.source = { 0, 0, 0, 0 };
+      SDL_ASSERT_SUCCESS(SDL_QueryTexture(texture, nullptr, nullptr, &command.source.w, &command.source.h));
+    }
+
+    SDL_ASSERT_SUCCESS(SDL_GetTextureBlendMode(texture, &command.blendMode));
+    Push(command);
+  }
+
+  void RenderCommandBuffer::Push(const RenderCommand& command)
+  {
+    assert(command.texture != nullptr);
+    _frameStats.commands++;
+
+    if (command.colorMod.a == 0 && command.blendMode != SDL_BLENDMODE_NONE)
+    {
+      return;
+    }
+
+    auto bounds = CommandBounds(command);
+    bounds.x += _offset.x;
+    bounds.y += _offset.y;
+    if (SDL_IntersectRect(&bounds, &_target, &bounds) == SDL_FALSE)
+    {
+      return;
+    }
+
+    auto ownClip = command.clip;
+    ownClip.x += _offset.x;
+    ownClip.y += _offset.y;
+
+    // A command with its own clip drawn while the buffer is clipped is limited by both
+    const auto clipped = command.clipped || _clipped;
+    auto clip = command.clipped ? ownClip : _clip;
+    if (command.clipped && _clipped && SDL_IntersectRect(&ownClip, &_clip, &clip) == SDL_FALSE)
+    {
+      return;
+    }
+
+    if (clipped && SDL_IntersectRect(&bounds, &clip, &bounds) == SDL_FALSE)
+    {
+      return;
+    }
+
+    if (command.texture != _lastPushedTexture)
+    {
+      _frameStats.unsortedTextureSwitches++;
+      _lastPushedTexture = command.texture;
+    }
+
+    _commands.push_back(command);
+    auto& pushed = _commands.back();
+    pushed.z = _currentZ;
+    pushed.destination.x += _offset.x;
+    pushed.destination.y += _offset.y;
+    pushed.clipped = clipped;
+    pushed.clip = clipped ? clip : Rectangle{ 0, 0, 0, 0 };
+    _commandBounds.push_back(bounds);
+  }
+
+  void RenderCommandBuffer::Flush(SDL_Renderer* renderer)
+  {
+    if (_commands.empty())
+    {
+      return;
+    }
+
+    _frameStats.flushes++;
+
+    Batch();
+    Submit(renderer);
+
+    _commands.clear();
+    _commandBounds.clear();
+    for (size_t b = 0; b < _usedBatches; b++)
+    {
+      _batches[b].commands.clear();
+    }
+  }
+
+  void RenderCommandBuffer::Batch()
+  {
+    // Batches are re-used between flushes to keep their command vectors allocated
+    _usedBatches = 0;
+
+    for (uint32_t i = 0; i < _commands.size(); i++)
+    {
+      const auto& command = _commands[i];
+      const auto& bounds = _commandBounds[i];
+
+      // Walk back through the batches, the command can join a batch with the same texture
+      // as long as it does not overlap anything that would then be drawn after it instead of before it
+      auto found = _usedBatches;
+      const auto lookbackEnd = _usedBatches > kMaxBatchLookback ? _usedBatches - kMaxBatchLookback : 0;
+      for (auto b = _usedBatches; b > lookbackEnd; b--)
+      {
+        const auto& batch = _batches[b - 1];
+        if (batch.texture == command.texture)
+        {
+          found = b - 1;
+          break;
+        }
+
+        if (SDL_HasIntersection(&batch.bounds, &bounds) == SDL_TRUE)
+        {
+          break;
+        }
+      }
+
+      if (found == _usedBatches)
+      {
+        if (_batches.size() == _usedBatches)
+        {
+          _batches.emplace_back();
+        }
+
+        auto& batch = _batches[_usedBatches++];
+        batch.texture = command.texture;
+        batch.bounds = bounds;
+        batch.commands.push_back(i);
+      }
+      else
+      {
+        auto& batch = _batches[found];
+        batch.bounds = Union(batch.bounds, bounds);
+        batch.commands.push_back(i);
+      }
+    }
+  }
+
+  void RenderCommandBuffer::SetColorMod(SDL_Texture* texture, const SDL_Color& colorMod, const SDL_BlendMode blendMode)
+  {
+    SDL_ASSERT_SUCCESS(SDL_SetTextureColorMod(texture, colorMod.r, colorMod.g, colorMod.b));
+    SDL_ASSERT_SUCCESS(SDL_SetTextureAlphaMod(texture, colorMod.a));
+
+    if (!IsNeutralColorMod(colorMod))
+    {
+      _modifiedTextures.push_back({ texture, blendMode });
+    }
+  }
+
+  void RenderCommandBuffer::Submit(SDL_Renderer* renderer)
+  {
+    SDL_Texture* currentTexture = nullptr;
+    SDL_Color currentColorMod = { 255, 255, 255, 255 };
+    SDL_BlendMode currentBlendMode = SDL_BLENDMODE_NONE;
+    bool clipped = false;
+    Rectangle clip = { 0, 0, 0, 0 };
+
+    for (size_t b = 0; b < _usedBatches; b++)
+    {
+      for (const auto index : _batches[b].commands)
+      {
+        const auto& command = _commands[index];
+
+        if (command.texture != currentTexture)
+        {
+          currentTexture = command.texture;
+          if (currentTexture != _lastDrawnTexture)
+          {
+            _frameStats.textureSwitches++;
+            _lastDrawnTexture = currentTexture;
+          }
+
+          // Textures are shared so their modulation is always set explicitly and reverted once the flush is done
+          SDL_ASSERT_SUCCESS(SDL_GetTextureBlendMode(currentTexture, &currentBlendMode));
+          SetColorMod(currentTexture, command.colorMod, currentBlendMode);
+          currentColorMod = command.colorMod;
+        }
+        else if (!IsSameColorMod(command.colorMod, currentColorMod))
+        {
+          SetColorMod(currentTexture, command.colorMod, currentBlendMode);
+          currentColorMod = command.colorMod;
+        }
+
+        if (command.blendMode != currentBlendMode)
+        {
+          _modifiedTextures.push_back({ currentTexture, currentBlendMode });
+          currentBlendMode = command.blendMode;
+          SDL_ASSERT_SUCCESS(SDL_SetTextureBlendMode(currentTexture, currentBlendMode));
+        }
+
+        if (command.clipped != clipped || (clipped && !IsSameRectangle(command.clip, clip)))
+        {
+          clipped = command.clipped;
+          clip = command.clip;
+          SDL_ASSERT_SUCCESS(SDL_RenderSetClipRect(renderer, clipped ? &clip : nullptr));
+        }
+
+        if (command.rotated)
+        {
+          SDL_RenderCopyEx(renderer, command.texture, &command.source, &command.destination, command.angle, nullptr, SDL_FLIP_NONE);
+        }
+        else
+        {
+          SDL_RenderCopy(renderer, command.texture, &command.source, &command.destination);
+        }
+
+        _frameStats.drawCalls++;
+      }
+    }
+
+    if (clipped)
+    {
+      SDL_ASSERT_SUCCESS(SDL_RenderSetClipRect(renderer, nullptr));
+    }
+
+    // Restore in reverse so a texture modified several times ends up with its original blend mode
+    for (auto it = _modifiedTextures.rbegin(); it != _modifiedTextures.rend(); ++it)
+    {
+      SDL_ASSERT_SUCCESS(SDL_SetTextureColorMod(it->first, 255, 255, 255));
+      SDL_ASSERT_SUCCESS(SDL_SetTextureAlphaMod(it->first, 255));
+      SDL_ASSERT_SUCCESS(SDL_SetTextureBlendMode(it->first, it->second));
+    }
+    _modifiedTextures.clear();
+  }
+}
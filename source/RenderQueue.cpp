@@ -0,0 +1,122 @@
+#include "RenderQueue.h"
+
+#include "IGameObject.h"
+
+#include <cassert>
+
+namespace JadeEngine
+{
+  RenderQueue::RenderQueue()
+    : _nextOrder(0)
+    , _fullyInvalidated(true)
+    , _tracking(false)
+  {
+  }
+
+  void RenderQueue::Insert(IGameObject* gameObject)
+  {
+    assert(gameObject != nullptr);
+    assert(gameObject->_renderQueue == nullptr);
+
+    gameObject->_renderQueue = this;
+    gameObject->_renderOrder = _nextOrder++;
+    _entries.insert({ gameObject->GetZ(), gameObject->_renderOrder, gameObject });
+    Invalidate(gameObject);
+  }
+
+  void RenderQueue::Remove(IGameObject* gameObject)
+  {
+    assert(gameObject != nullptr);
+    assert(gameObject->_renderQueue == this);
+
+    const auto erased = _entries.erase({ gameObject->GetZ(), gameObject->_renderOrder, gameObject });
+    assert(erased == 1);
+    gameObject->_renderQueue = nullptr;
+
+    if (gameObject->_invalidated)
+    {
+      const auto last = _invalidatedObjects.back();
+      _invalidatedObjects[gameObject->_invalidatedIndex] = last;
+      last->_invalidatedIndex = gameObject->_invalidatedIndex;
+      _invalidatedObjects.pop_back();
+      gameObject->_invalidated = false;
+    }
+
+    // Whatever was drawn below the object shows up again
+    if (_tracking && SDL_RectEmpty(&gameObject->_renderedBounds) == SDL_FALSE)
+    {
+      _exposedAreas.push_back(gameObject->_renderedBounds);
+      gameObject->_renderedBounds = { 0, 0, 0, 0 };
+    }
+  }
+
+  void RenderQueue::Clear()
+  {
+    for (const auto& entry : _entries)
+    {
+      entry.gameObject->_renderQueue = nullptr;
+      entry.gameObject->_invalidated = false;
+      entry.gameObject->_renderedBounds = { 0, 0, 0, 0 };
+    }
+    _entries.clear();
+    _invalidatedObjects.clear();
+    _exposedAreas.clear();
+    _fullyInvalidated = true;
+  }
+
+  void RenderQueue::Rekey(IGameObject* gameObject, const int32_t oldZ)
+  {
+    assert(gameObject->_renderQueue == this);
+
+    // Re-use the node instead of allocating a new one
+    auto node = _entries.extract({ oldZ, gameObject->_renderOrder, gameObject });
+    assert(!node.empty());
+    node.value().z = gameObject->GetZ();
+    _entries.insert(std::move(node));
+    Invalidate(gameObject);
+  }
+
+  void RenderQueue::SetChangeTracking(const bool tracking)
+  {
+    if (_tracking == tracking)
+    {
+      return;
+    }
+
+    _tracking = tracking;
+    for (const auto gameObject : _invalidatedObjects)
+    {
+      gameObject->_invalidated = false;
+    }
+    _invalidatedObjects.clear();
+    _exposedAreas.clear();
+    _fullyInvalidated = true;
+  }
+
+  void RenderQueue::Invalidate(IGameObject* gameObject)
+  {
+    if (_tracking && !gameObject->_invalidated)
+    {
+      gameObject->_invalidated = true;
+      gameObject->_invalidatedIndex = _invalidatedObjects.size();
+      _invalidatedObjects.push_back(gameObject);
+    }
+  }
+
+  bool RenderQueue::TakeInvalidated(std::vector<IGameObject*>& gameObjects, std::vector<Rectangle>& areas)
+  {
+    for (const auto gameObject : _invalidatedObjects)
+    {
+      gameObject->_invalidated = false;
+    }
+
+    gameObjects.insert(std::end(gameObjects), std::cbegin(_invalidatedObjects), std::cend(_invalidatedObjects));
+    areas.insert(std::end(areas), std::cbegin(_exposedAreas), std::cend(_exposedAreas));
+    _invalidatedObjects.clear();
+    _exposedAreas.clear();
+
+    const auto fullyInvalidated = _fullyInvalidated;
+    _fullyInvalidated = false;
+    return fullyInvalidated;
+  }
+}
@@ -0,0 +1,116 @@
+#include "SkylinePacker.h"
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+
+namespace JadeEngine
+{
+  SkylinePacker::SkylinePacker(const int32_t width, const int32_t height)
+    : _width(width)
+    , _height(height)
+    , _skyline{ { 0, 0, width } }
+  {
+    assert(width > 0 && height > 0);
+  }
+
+  bool SkylinePacker::Insert(const int32_t width, const int32_t height, Rectangle& result)
+  {
+    auto bestIndex = _skyline.size();
+    auto bestY = std::numeric_limits<int32_t>::max();
+    auto bestWidth = std::numeric_limits<int32_t>::max();
+
+    for (size_t i = 0; i < _skyline.size(); i++)
+    {
+      int32_t y;
+      if (Fits(i, width, height, y))
+      {
+        // Prefer the lowest top edge, ties go to the narrowest segment to leave wide gaps for wide rectangles
+        if (y + height < bestY || (y + height == bestY && _skyline[i].width < bestWidth))
+        {
+          bestIndex = i;
+          bestY = y + height;
+          bestWidth = _skyline[i].width;
+        }
+      }
+    }
+
+    if (bestIndex == _skyline.size())
+    {
+      return false;
+    }
+
+    result = { _skyline[bestIndex].x, bestY - height, width, height };
+    AddSegment(bestIndex, result);
+    return true;
+  }
+
+  bool SkylinePacker::Fits(const size_t index, const int32_t width, const int32_t height, int32_t& y) const
+  {
+    const auto x = _skyline[index].x;
+    if (x + width > _width)
+    {
+      return false;
+    }
+
+    // The rectangle rests on the highest segment it spans
+    auto widthLeft = width;
+    auto i = index;
+    y = _skyline[index].y;
+    while (widthLeft > 0)
+    {
+      y = std::max(y, _skyline[i].y);
+      if (y + height > _height)
+      {
+        return false;
+      }
+      widthLeft -= _skyline[i].width;
+      i++;
+    }
+
+    return true;
+  }
+
+  void SkylinePacker::AddSegment(const size_t index, const Rectangle& placed)
+  {
+    _skyline.insert(std::begin(_skyline) + index, { placed.x, placed.y + placed.h, placed.w });
+
+    // Shrink or remove the segments now covered by the new one
+    for (auto i = index + 1; i < _skyline.size();)
+    {
+      auto& segment = _skyline[i];
+      const auto& previous = _skyline[i - 1];
+      const auto previousEnd = previous.x + previous.width;
+      if (segment.x >= previousEnd)
+      {
+        break;
+      }
+
+      const auto shrink = previousEnd - segment.x;
+      segment.x += shrink;
+      segment.width -= shrink;
+      if (segment.width <= 0)
+      {
+        _skyline.erase(std::begin(_skyline) + i);
+      }
+      else
+      {
+        break;
+      }
+    }
+
+    // Merge neighbours of the same height
+    for (size_t i = 0; i + 1 < _skyline.size();)
+    {
+      if (_skyline[i].y == _skyline[i + 1].y)
+      {
+        _skyline[i].width += _skyline[i + 1].width;
+        _skyline.erase(std::begin(_skyline) + i + 1);
+      }
+      else
+      {
+        i++;
+      }
+    }
+  }
+}
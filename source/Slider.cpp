@@ -5,6 +5,7 @@
 #include "Sprite.h"
 #include "Text.h"
 #include "Transform.h"
+#include "UIEvents.h"
 #include "Utils.h"
 
 namespace JadeEngine
@@ -14,9 +15,13 @@ namespace JadeEngine
     , _width(params.width)
     , _minMaxYMargin(params.minMaxYMargin)
     , _slidingOffset(0)
-    , _slidingReleased(false)
+    , _releasedFrame(0)
+    , _valueChanged(false)
     , _value (Clamp01(params.initialValue))
   {
+    // Only updated every frame while the pointer is dragged
+    SetUpdatePolicy(kUpdatePolicy_OnWake);
+
     SpriteParams spriteParams;
     spriteParams.layer = params.layer;
     spriteParams.textureName = params.axisTexture;
@@ -62,29 +67,42 @@ namespace JadeEngine
     transform->SetPosition(0, 0);
   }
 
-  void Slider::Update()
+  bool Slider::Released() const
   {
-    if (_valueChanged)
-    {
-      _valueChanged = false;
-    }
+    return _releasedFrame == GGame.GetUIEventFrame();
+  }
 
-    if (_slidingReleased)
+  void Slider::OnUIEvent(UIEvent& event)
+  {
+    if (event.phase == kUIEventPhase_Capture || event.mouseButton != SDL_BUTTON_LEFT)
     {
-      _slidingReleased = false;
+      return;
     }
 
-    if (!_sliding && GGame.GetHoveredSprite() == _pointer && GInput.MouseButtonDown(SDL_BUTTON_LEFT))
+    if (!_sliding && event.type == kUIEventType_Press && event.target == _pointer)
     {
       _sliding = true;
       _slidingOffset = GInput.GetMouseX() - _pointer->transform->GetCenterX();
+      event.handled = true;
+
+      GGame.CaptureMouse(this);
+      SetUpdatePolicy(kUpdatePolicy_EveryFrame);
     }
-    else if (_sliding && !GInput.MouseButtonDown(SDL_BUTTON_LEFT))
+    else if (_sliding && event.type == kUIEventType_Release)
     {
       _sliding = false;
-      _slidingReleased = true;
+      _releasedFrame = event.frame;
       _slidingOffset = 0;
+      event.handled = true;
+
+      GGame.ReleaseMouse(this);
+      SetUpdatePolicy(kUpdatePolicy_OnWake);
     }
+  }
+
+  void Slider::Update()
+  {
+    _valueChanged = false;
 
     if (_sliding)
     {
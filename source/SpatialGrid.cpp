@@ -0,0 +1,143 @@
+#include "SpatialGrid.h"
+
+#include "Sprite.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace JadeEngine
+{
+  int32_t SpatialGrid::GetSpriteZ(const Sprite* sprite)
+  {
+    return sprite->GetZ();
+  }
+
+  int32_t SpatialGrid::CellCoordinate(const int32_t coordinate)
+  {
+    // Round towards negative infinity so cells left and above of the origin do not overlap the first one
+    return coordinate >= 0 ? coordinate / kSpatialGridCellSize : -((-coordinate + kSpatialGridCellSize - 1) / kSpatialGridCellSize);
+  }
+
+  uint64_t SpatialGrid::CellKey(const int32_t cellX, const int32_t cellY)
+  {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(cellX)) << 32) | static_cast<uint32_t>(cellY);
+  }
+
+  SpatialGrid::CellRange SpatialGrid::ToCellRange(const Box_i32& box)
+  {
+    // Mouse tests are inclusive of the right and bottom edge, see IsInsideRect
+    return {
+      CellCoordinate(box.position.x),
+      CellCoordinate(box.position.y),
+      CellCoordinate(box.position.x + std::max(box.size.w, 0)),
+      CellCoordinate(box.position.y + std::max(box.size.h, 0))
+    };
+  }
+
+  bool SpatialGrid::IsOversized(const CellRange& range)
+  {
+    const auto cellsX = static_cast<int64_t>(range.maxX) - range.minX + 1;
+    const auto cellsY = static_cast<int64_t>(range.maxY) - range.minY + 1;
+    return cellsX * cellsY > kSpatialGridMaxCellsPerSprite;
+  }
+
+  void SpatialGrid::AddToCells(Sprite* sprite, const CellRange& range)
+  {
+    if (IsOversized(range))
+    {
+      _oversized.push_back(sprite);
+      return;
+    }
+
+    for (auto y = range.minY; y <= range.maxY; y++)
+    {
+      for (auto x = range.minX; x <= range.maxX; x++)
+      {
+        _cells[CellKey(x, y)].push_back(sprite);
+      }
+    }
+  }
+
+  void SpatialGrid::RemoveFromCells(Sprite* sprite, const CellRange& range)
+  {
+    const auto removeFrom = [&](std::vector<Sprite*>& sprites)
+    {
+      const auto found = std::find(std::begin(sprites), std::end(sprites), sprite);
+      assert(found != std::end(sprites));
+      if (found != std::end(sprites))
+      {
+        // Order within a cell does not matter, FindTopmost compares Z
+        *found = sprites.back();
+        sprites.pop_back();
+      }
+    };
+
+    if (IsOversized(range))
+    {
+      removeFrom(_oversized);
+      return;
+    }
+
+    for (auto y = range.minY; y <= range.maxY; y++)
+    {
+      for (auto x = range.minX; x <= range.maxX; x++)
+      {
+        auto cell = _cells.find(CellKey(x, y));
+        assert(cell != std::end(_cells));
+        if (cell != std::end(_cells))
+        {
+          removeFrom(cell->second);
+          if (cell->second.empty())
+          {
+            _cells.erase(cell);
+          }
+        }
+      }
+    }
+  }
+
+  void SpatialGrid::Insert(Sprite* sprite, const Box_i32& box)
+  {
+    assert(sprite != nullptr);
+    assert(_ranges.count(sprite) == 0);
+
+    const auto range = ToCellRange(box);
+    _ranges[sprite] = range;
+    AddToCells(sprite, range);
+  }
+
+  void SpatialGrid::Move(Sprite* sprite, const Box_i32& box)
+  {
+    auto found = _ranges.find(sprite);
+    assert(found != std::end(_ranges));
+    if (found == std::end(_ranges))
+    {
+      return;
+    }
+
+    const auto range = ToCellRange(box);
+    if (!(found->second == range))
+    {
+      RemoveFromCells(sprite, found->second);
+      AddToCells(sprite, range);
+      found->second = range;
+    }
+  }
+
+  void SpatialGrid::Remove(Sprite* sprite)
+  {
+    auto found = _ranges.find(sprite);
+    if (found != std::end(_ranges))
+    {
+      RemoveFromCells(sprite, found->second);
+      _ranges.erase(found);
+    }
+  }
+
+  void SpatialGrid::Clear()
+  {
+    _cells.clear();
+    _ranges.clear();
+    _oversized.clear();
+  }
+}
@@ -7,6 +7,7 @@
 #include "Utils.h"
 
 #include <cassert>
+#include <cmath>
 #include <SDL.h>
 
 namespace JadeEngine
@@ -20,12 +21,16 @@ namespace JadeEngine
 
   Sprite::Sprite(const SpriteParams& params)
     : _alpha(1.0f)
+    , _colorMod{255, 255, 255, 255}
     , _layer(params.layer)
     , _rotated(false)
     , _rotationAngle(0)
     , _spriteSheetDescription(nullptr)
+    , _spriteSheetMasked(false)
   {
     _z = params.z;
+    SetRenderMode(kRenderMode_Commands);
+    AddCapabilities(kObjectCapability_Sprite);
     if (params.spriteSheet)
     {
       _spriteSheetDescription = GGame.GetSpriteSheetDescription(params.spriteSheetName);
@@ -64,10 +69,12 @@ namespace JadeEngine
 
   Sprite::Sprite(const ObjectLayer layer, std::shared_ptr<Texture> texture, const int32_t z)
     : _alpha(1.0f)
+    , _colorMod{255, 255, 255, 255}
     , _layer(layer)
     , _rotated(false)
     , _rotationAngle(0)
     , _spriteSheetDescription(nullptr)
+    , _spriteSheetMasked(false)
     , _texture(texture->texture)
     , _textureDescription(texture)
     , _textureName(texture->name)
@@ -75,6 +82,8 @@ namespace JadeEngine
     transform->Initialize(0, 0, texture->width, texture->height);
     transform->SetBoundingBox(texture->boundingBox);
     _z = z;
+    SetRenderMode(kRenderMode_Commands);
+    AddCapabilities(kObjectCapability_Sprite);
     SetLoadState(kLoadState_Done);
     assert(_textureDescription);
   }
@@ -82,34 +91,42 @@ namespace JadeEngine
   void Sprite::Render(SDL_Renderer* renderer)
   {
     SDL_Rect destination = _layer == kObjectLayer_World ? GWorldCamera.WorldToScreen(transform) : transform->GetBox();
-    auto maskCopy = _spriteSheetMask;
-    SDL_Rect* source = _spriteSheetMasked ? &maskCopy : nullptr;
+    const SDL_Rect* source = _spriteSheetMasked ? &_spriteSheetMask : &_textureDescription->source;
 
+    GGame.GetRenderCommands().Push(_texture, source, destination, _colorMod, _rotated ? _rotationAngle : 0.0);
+  }
+
+  Rectangle Sprite::GetRenderBounds() const
+  {
+    Rectangle bounds = _layer == kObjectLayer_World ? GWorldCamera.WorldToScreen(transform) : transform->GetBox();
     if (_rotated)
     {
-      SDL_RenderCopyEx(renderer, _texture, source, &destination, _rotationAngle, nullptr, SDL_FLIP_NONE);
-    }
-    else
-    {
-      SDL_RenderCopy(renderer, _texture, source, &destination);
+      // Rotation is around the center, the rotated rectangle always fits into the circle around it
+      const auto radius = static_cast<int32_t>(std::ceil(std::sqrt(static_cast<double>(bounds.w) * bounds.w
+        + static_cast<double>(bounds.h) * bounds.h) / 2.0));
+      bounds = { bounds.x + bounds.w / 2 - radius, bounds.y + bounds.h / 2 - radius, 2 * radius + 1, 2 * radius + 1 };
     }
+
+    return bounds;
   }
 
   void Sprite::Tint(const SDL_Color& tintColor)
   {
-    MakeTextureUnique();
-    SDL_SetTextureColorMod(_texture, tintColor.r, tintColor.g, tintColor.b);
+    _colorMod.r = tintColor.r;
+    _colorMod.g = tintColor.g;
+    _colorMod.b = tintColor.b;
+    Invalidate();
   }
 
   bool Sprite::HasHitTest() const
   {
-    return _textureDescription->hitArray.size() > 0;
+    return _textureDescription->hitMask != nullptr;
   }
 
   bool Sprite::HitTest(const int32_t x, const int32_t y) const
   {
     assert(HasHitTest());
-    return _textureDescription->hitArray[x + y * transform->GetWidth()];
+    return _textureDescription->hitMask->Test(x, y);
   }
 
   const std::string& Sprite::GetTextureName() const
@@ -132,6 +149,7 @@ namespace JadeEngine
     assert(_spriteSheetMasked);
     _spriteSheetMask = mask;
     transform->SetBoundingBox({ 0, 0, _spriteSheetMask.w, _spriteSheetMask.h });
+    Invalidate();
   }
 
   void Sprite::MakeTextureUnique()
@@ -140,19 +158,15 @@ namespace JadeEngine
     {
       _textureDescription = GGame.CopyTexture(_textureDescription, _textureDescription->sampling);
       _texture = _textureDescription->texture;
+      Invalidate();
     }
   }
 
   void Sprite::SetAlpha(const float alpha)
   {
-    if (_alpha != Clamp01(alpha))
-    {
-      MakeTextureUnique();
-
-      _alpha = Clamp01(alpha);
-      auto aplhaMod = static_cast<uint8_t>(_alpha * 255.0f);
-      SDL_SetTextureAlphaMod(_texture, aplhaMod);
-    }
+    _alpha = Clamp01(alpha);
+    _colorMod.a = static_cast<uint8_t>(_alpha * 255.0f);
+    Invalidate();
   }
 
   float Sprite::GetAlpha() const
@@ -170,6 +184,7 @@ namespace JadeEngine
   {
     _rotated = true;
     _rotationAngle = angle;
+    Invalidate();
   }
 
   void Sprite::SetSampling(const TextureSampling sampling)
@@ -178,6 +193,7 @@ namespace JadeEngine
     {
       _textureDescription = GGame.CopyTexture(_textureDescription, sampling);
       _texture = _textureDescription->texture;
+      Invalidate();
     }
   }
 
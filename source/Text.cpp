@@ -10,13 +10,14 @@ namespace JadeEngine
 {
   Text::Text(const TextParams& params)
     : _text(params.text)
-    , _cachedTexture(nullptr)
+    , _layout{ {}, 0, 0 }
     , _color(params.color)
     , _masked(false)
     , _mask{0, 0, 0, 0}
   {
     _z = params.z;
     SetLoadState(kLoadState_Wanted);
+    SetRenderMode(kRenderMode_Commands);
     _font = GGame.FindFont(params.fontName, params.fontSize);
 
     transform->Initialize(kZeroVector2D_i32, kZeroVector2D_i32);
@@ -28,26 +29,18 @@ namespace JadeEngine
   {
     if (_text.size() == 0)
     {
+      _layout.quads.clear();
       transform->SetSize(0, 0);
       return kLoadState_Done;
     }
 
-    auto surface = TTF_RenderText_Blended(_font, _text.c_str(), _color);
+    auto glyphAtlas = GGame.GetGlyphAtlas(_font);
 
-    if (surface != nullptr)
+    if (glyphAtlas != nullptr)
     {
-      if (_color.a < 255)
-      {
-        SDL_ASSERT_SUCCESS(SDL_SetSurfaceAlphaMod(surface, _color.a));
-      }
-
-      transform->SetSize(surface->w, surface->h);
-
-      _cachedTexture = SDL_CreateTextureFromSurface(renderer, surface);
-      SDL_ASSERT_SUCCESS(SDL_SetTextureBlendMode(_cachedTexture, SDL_BLENDMODE_BLEND));
-      SDL_FreeSurface(surface);
-
-      return _cachedTexture != nullptr ? kLoadState_Done : kLoadState_Abandoned;
+      glyphAtlas->Layout(_text, 0, _layout);
+      transform->SetSize(_layout.width, _layout.height);
+      return kLoadState_Done;
     }
     else
     {
@@ -60,34 +53,18 @@ namespace JadeEngine
   {
     _masked = true;
     _mask = mask;
+    Invalidate();
   }
 
   void Text::Render(SDL_Renderer* renderer)
   {
-    if (_cachedTexture != nullptr)
-    {
-      SDL_Rect destination = transform->GetBox();
-
-      if (_masked)
-      {
-        SDL_Rect interesection;
-        if (SDL_IntersectRect(&destination, &_mask, &interesection) != SDL_FALSE)
-        {
-          SDL_Rect source = { interesection.x - destination.x, interesection.y - destination.y, interesection.w, interesection.h };
-          SDL_RenderCopy(renderer, _cachedTexture, &source, &interesection);
-        }
-      }
-      else
-      {
-        SDL_RenderCopy(renderer, _cachedTexture, nullptr, &destination);
-      }
-    }
+    GlyphAtlas::Render(GGame.GetRenderCommands(), _layout, transform->GetX(), transform->GetY(), _color, _masked ? &_mask : nullptr);
   }
 
   void Text::SetTextFast(const std::string& text)
   {
     _text = text;
-    RemoveCache();
+    Relayout();
   }
 
   void Text::SetText(const std::string& text)
@@ -100,9 +77,8 @@ namespace JadeEngine
 
   void Text::SetTextAndColor(const std::string& text, const SDL_Color& color)
   {
-    _color = color;
-    _text = text;
-    RemoveCache();
+    SetColor(color);
+    SetText(text);
   }
 
   void Text::SetColor(const SDL_Color& color)
@@ -115,19 +91,13 @@ namespace JadeEngine
 
   void Text::SetColorFast(const SDL_Color& color)
   {
+    // Glyphs are color modulated at render time, nothing to rebuild
     _color = color;
-    RemoveCache();
+    Invalidate();
   }
 
-  void Text::RemoveCache()
+  void Text::Relayout()
   {
-    SDL_DestroyTexture(_cachedTexture);
-    _cachedTexture = nullptr;
     SetLoadState(kLoadState_Wanted);
   }
-
-  void Text::Clean()
-  {
-    SDL_DestroyTexture(_cachedTexture);
-  }
 }
\ No newline at end of file
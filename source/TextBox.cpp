@@ -11,12 +11,14 @@ namespace JadeEngine
     : _color(params.color)
     , _width(params.width)
     , _height(0)
+    , _wrapWidth(params.width)
     , _text(params.text)
-    , _cachedTexture(nullptr)
+    , _layout{ {}, 0, 0 }
     , _x(0)
     , _y(0)
   {
     SetLoadState(kLoadState_Wanted);
+    SetRenderMode(kRenderMode_Commands);
     _z = params.z;
     _font = GGame.FindFont(params.fontName, params.fontSize);
     assert(_font != nullptr);
@@ -26,26 +28,20 @@ namespace JadeEngine
   {
     if (_text.size() == 0)
     {
+      _layout.quads.clear();
       _width = 0;
       _height = 0;
       return kLoadState_Done;
     }
 
-    auto surface = TTF_RenderText_Blended_Wrapped(_font, _text.c_str(), _color, _width);
+    auto glyphAtlas = GGame.GetGlyphAtlas(_font);
 
-    if (surface != nullptr)
+    if (glyphAtlas != nullptr)
     {
-      if (_color.a < 255)
-      {
-        SDL_SetSurfaceAlphaMod(surface, _color.a);
-      }
-
-      _width = surface->w;
-      _height = surface->h;
-      _cachedTexture = SDL_CreateTextureFromSurface(renderer, surface);
-      SDL_FreeSurface(surface);
-
-      return _cachedTexture != nullptr ? kLoadState_Done : kLoadState_Abandoned;
+      glyphAtlas->Layout(_text, _wrapWidth, _layout);
+      _width = _layout.width;
+      _height = _layout.height;
+      return kLoadState_Done;
     }
     else
     {
@@ -56,22 +52,16 @@ namespace JadeEngine
 
   void TextBox::Render(SDL_Renderer* renderer)
   {
-    if (_cachedTexture != nullptr)
-    {
-      SDL_Rect destination = { _x , _y , _width, _height };
-      SDL_RenderCopy(renderer, _cachedTexture, nullptr, &destination);
-    }
+    GlyphAtlas::Render(GGame.GetRenderCommands(), _layout, _x, _y, _color, nullptr);
   }
 
-  void TextBox::Clean()
+  Rectangle TextBox::GetRenderBounds() const
   {
-    RemoveCache();
+    return { _x, _y, _width, _height };
   }
 
-  void TextBox::RemoveCache()
+  void TextBox::Relayout()
   {
-    SDL_DestroyTexture(_cachedTexture);
-    _cachedTexture = nullptr;
     SetLoadState(kLoadState_Wanted);
   }
 
@@ -79,18 +69,20 @@ namespace JadeEngine
   {
     _x = x;
     _y = y;
+    Invalidate();
   }
 
   void TextBox::SetCenterPosition(int32_t x, int32_t y)
   {
     _x = x - GetWidth() / 2;
     _y = y - GetHeight() / 2;
+    Invalidate();
   }
 
   void TextBox::SetText(const std::string& text)
   {
     _text = text;
-    RemoveCache();
+    Relayout();
   }
 
   int32_t TextBox::GetX() const { return _x; }
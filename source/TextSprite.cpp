@@ -24,6 +24,7 @@ namespace JadeEngine
         params.spriteSheetName
       })
     , _cachedTextTexture(nullptr)
+    , _finalTexture(nullptr)
   {
     SetLoadState(kLoadState_Wanted);
 
@@ -95,10 +96,14 @@ namespace JadeEngine
         // dstRGB = srcRGB * [1,1,1] + dstRGB * [0,0,0] (throwaway existing text color information and use image colors)
         // dstA = srcA * dstA + dstA * srcA (render only pixels that have non-zero alpha in both src and dst)
         const auto customBlendMode = SDL_ComposeCustomBlendMode(SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ZERO, SDL_BLENDOPERATION_ADD, SDL_BLENDFACTOR_DST_ALPHA, SDL_BLENDFACTOR_SRC_ALPHA, SDL_BLENDOPERATION_ADD);
+        // The image texture can be shared with other sprites or be an atlas page, its blend mode is restored afterwards
+        SDL_BlendMode originalBlendMode;
+        SDL_GetTextureBlendMode(_texture, &originalBlendMode);
         SDL_SetTextureBlendMode(_texture, customBlendMode);
 
         // Render image texture to the Render-To-Texture target with the above special sauce blend mode
-        SDL_RenderCopy(renderer, _texture, nullptr, nullptr);
+        SDL_RenderCopy(renderer, _texture, &_textureDescription->source, nullptr);
+        SDL_SetTextureBlendMode(_texture, originalBlendMode);
 
         SDL_SetRenderTarget(renderer, nullptr);
 
@@ -120,13 +125,9 @@ namespace JadeEngine
     SDL_Rect destination = _layer == kObjectLayer_World ? GWorldCamera.WorldToScreen(transform) : transform->GetBox();
 
     SDL_Rect* source = _spriteSheetMasked ? &_spriteSheetMask : nullptr;
-    if (_rotated)
+    if (_finalTexture != nullptr)
     {
-      SDL_RenderCopyEx(renderer, _finalTexture, source, &destination, _rotationAngle, nullptr, SDL_FLIP_NONE);
-    }
-    else
-    {
-      SDL_RenderCopy(renderer, _finalTexture, source, &destination);
+      GGame.GetRenderCommands().Push(_finalTexture, source, destination, _colorMod, _rotated ? _rotationAngle : 0.0);
     }
   }
 }
\ No newline at end of file
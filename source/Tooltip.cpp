@@ -45,6 +45,9 @@ namespace JadeEngine
       const auto previousHeight = _boxSprite->transform->GetHeight();
       _boxSprite->transform->SetHeight(_textBox->GetHeight() + _padding * 2);
       SetPosition(GetX(), GetY() - (GetHeight() - previousHeight));
+
+      // Nothing else to wait for
+      SetUpdatePolicy(kUpdatePolicy_Never);
     }
   }
 
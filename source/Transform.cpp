@@ -1,88 +1,100 @@
 #include "Transform.h"
 
-#include <algorithm>
-#include <cassert>
+namespace
+{
+  const uint8_t kPositionDirtyFlags = (1 << JadeEngine::kDirtyFlag_Position) | (1 << JadeEngine::kDirtyFlag_CenterPosition);
+  const uint8_t kSizeDirtyFlags = (1 << JadeEngine::kDirtyFlag_Size) | (1 << JadeEngine::kDirtyFlag_CenterPosition);
+}
 
 namespace JadeEngine
 {
-  Transform::Transform()
-    : _boundingBox(0, 0, 0, 0)
-    , _boundingBoxSet(false)
-    , _centerPosition(0, 0)
-    , _dirtyFlags(0)
-    , _dirtyFlagsCurrentFrame(0)
-    , _parent(nullptr)
-    , _position(0, 0)
-    , _size(0, 0)
-    , _transformationBox(0, 0, 0, 0)
+  void Transform::Initialize(const Vector2D_i32& position, const Vector2D_i32& size) const
   {
+    auto& system = GTransformSystem;
+    const auto slot = Slot();
+
+    system._positions[slot] = position;
+    system._sizes[slot] = size;
+    system._centerPositions[slot] = position + size / 2;
+    system._boundingBoxes[slot] = { {0, 0}, size };
+    system._boundingBoxesSet[slot] = false;
   }
 
-  void Transform::Initialize(const Vector2D_i32& position, const Vector2D_i32& size)
+  void Transform::Initialize(const int32_t x, const int32_t y, const int32_t w, const int32_t h) const
   {
-    _position = position;
-    _size = size;
-    _transformationBox = { position, size };
-    _centerPosition = _position + _size / 2;
-    _boundingBox = { {0, 0}, size };
-    _boundingBoxSet = false;
+    Initialize({ x, y }, { w, h });
   }
 
-  void Transform::Initialize(const int32_t x, const int32_t y, const int32_t w, const int32_t h)
+  void Transform::SetPosition(const int32_t x, const int32_t y) const
   {
-    Initialize({ x, y }, { w, h });
+    SetPosition({ x ,y });
   }
 
-  void Transform::SetPosition(const int32_t x, const int32_t y)
+  void Transform::SetPosition(const Vector2D_i32& position) const
   {
-    SetPosition({ x ,y });
+    SetPosition(ResolvedSlot(), position);
   }
 
-  void Transform::SetPosition(const Vector2D_i32& position)
+  void Transform::SetPosition(const uint32_t slot, const Vector2D_i32& position)
   {
-    if (position != _position)
+    auto& system = GTransformSystem;
+    if (position != system._positions[slot])
     {
-      _dirtyFlagsCurrentFrame.set(kDirtyFlag_CenterPosition);
-      _dirtyFlagsCurrentFrame.set(kDirtyFlag_Position);
-      _position = position;
-      _centerPosition = _position + _size / 2;
-      _transformationBox = { _position, _size };
+      system.MarkDirty(slot, kPositionDirtyFlags);
+      system._positions[slot] = position;
+      system._centerPositions[slot] = position + system._sizes[slot] / 2;
 
-      for (const auto& child : _children)
-      {
-        child->OnAttachedPositionChange();
-      }
+      MoveChildren(slot);
     }
   }
 
-  void Transform::SetCenterPosition(const int32_t centerX, const int32_t centerY)
+  void Transform::SetCenterPosition(const int32_t centerX, const int32_t centerY) const
   {
     SetCenterPosition({ centerX, centerY });
   }
 
-  void Transform::SetCenterPosition(const Vector2D_i32& centerPosition)
+  void Transform::SetCenterPosition(const Vector2D_i32& centerPosition) const
+  {
+    SetCenterPosition(ResolvedSlot(), centerPosition);
+  }
+
+  void Transform::SetCenterPosition(const uint32_t slot, const Vector2D_i32& centerPosition)
   {
-    if (centerPosition != _centerPosition)
+    auto& system = GTransformSystem;
+    if (centerPosition != system._centerPositions[slot])
     {
-      _dirtyFlagsCurrentFrame.set(kDirtyFlag_CenterPosition);
-      _dirtyFlagsCurrentFrame.set(kDirtyFlag_Position);
-      _centerPosition = centerPosition;
-      _position = _centerPosition - _size / 2;
-      _transformationBox = { _position, _size };
+      system.MarkDirty(slot, kPositionDirtyFlags);
+      system._centerPositions[slot] = centerPosition;
+      system._positions[slot] = centerPosition - system._sizes[slot] / 2;
 
-      for (const auto& child : _children)
+      MoveChildren(slot);
+    }
+  }
+
+  void Transform::MoveChildren(const uint32_t slot)
+  {
+    auto& system = GTransformSystem;
+    if (system._deferredPropagation)
+    {
+      if (system._firstChildren[slot] != kInvalidTransformSlot)
       {
-        child->OnAttachedPositionChange();
+        system.MarkPropagationPending(slot);
       }
+      return;
+    }
+
+    for (auto child = system._firstChildren[slot]; child != kInvalidTransformSlot; child = system._nextSiblings[child])
+    {
+      OnAttachedPositionChange(child);
     }
   }
 
-  void Transform::SetPositionAnchor(const int32_t x, const int32_t y, const Anchor& point)
+  void Transform::SetPositionAnchor(const int32_t x, const int32_t y, const Anchor& point) const
   {
     SetPositionAnchor({ x, y }, point);
   }
 
-  void Transform::SetPositionAnchor(const Vector2D_i32& position, const Anchor& point)
+  void Transform::SetPositionAnchor(const Vector2D_i32& position, const Anchor& point) const
   {
     if (point == kAnchor_Center)
     {
@@ -125,198 +137,206 @@ namespace JadeEngine
     SetPosition(destination);
   }
 
-  void Transform::SetHeight(const int32_t height)
+  void Transform::SetHeight(const int32_t height) const
   {
     SetSize({ GetWidth(), height });
   }
 
-  void Transform::SetWidth(const int32_t width)
+  void Transform::SetWidth(const int32_t width) const
   {
     SetSize({ width, GetHeight() });
   }
 
-  void Transform::SetSize(const int32_t width, const int32_t height)
+  void Transform::SetSize(const int32_t width, const int32_t height) const
   {
     SetSize({ width, height });
   }
 
-  void Transform::SetSize(const Vector2D_i32& size)
+  void Transform::SetSize(const Vector2D_i32& size) const
   {
-    if (size != _size)
+    auto& system = GTransformSystem;
+    const auto slot = ResolvedSlot();
+
+    if (size != system._sizes[slot])
     {
-      _dirtyFlagsCurrentFrame.set(kDirtyFlag_CenterPosition);
-      _dirtyFlagsCurrentFrame.set(kDirtyFlag_Size);
-      _size = size;
-      _centerPosition = _position + _size / 2;
-      _transformationBox = { _position, _size };
+      system.MarkDirty(slot, kSizeDirtyFlags);
+      system._sizes[slot] = size;
+      system._centerPositions[slot] = system._positions[slot] + size / 2;
 
-      for (const auto& child : _children)
-      {
-        child->OnAttachedPositionChange();
-      }
+      MoveChildren(slot);
 
-      if (!_boundingBoxSet)
+      if (!system._boundingBoxesSet[slot])
       {
-        _boundingBox.size = size;
-        _dirtyFlagsCurrentFrame.set(kDirtyFlag_BoundingBox);
+        system._boundingBoxes[slot].size = size;
+        system.MarkDirty(slot, 1 << kDirtyFlag_BoundingBox);
       }
 
-      if (IsAttached() && _attachmentData.childAnchor != kAnchor_LeftTop)
+      if (system._parents[slot] != kInvalidTransformSlot && system._attachments[slot].childAnchor != kAnchor_LeftTop)
       {
-        OnAttachedPositionChange();
+        OnAttachedPositionChange(slot);
       }
     }
   }
 
-  void Transform::SetBoundingBox(const Box_i32& box)
+  void Transform::SetBoundingBox(const Box_i32& box) const
   {
-    _boundingBoxSet = true;
-    if (box.position != _boundingBox.position || box.size != _boundingBox.size)
+    auto& system = GTransformSystem;
+    const auto slot = Slot();
+
+    system._boundingBoxesSet[slot] = true;
+    auto& boundingBox = system._boundingBoxes[slot];
+    if (box.position != boundingBox.position || box.size != boundingBox.size)
     {
-      _dirtyFlagsCurrentFrame.set(kDirtyFlag_BoundingBox);
-      _boundingBox.position = box.position;
-      _boundingBox.size = box.size;
+      system.MarkDirty(slot, 1 << kDirtyFlag_BoundingBox);
+      boundingBox.position = box.position;
+      boundingBox.size = box.size;
     }
   }
 
   Box_i32 Transform::GetTestingBox() const
   {
-    return { _boundingBox.position + _position, _boundingBox.size };
+    const auto& system = GTransformSystem;
+    const auto slot = ResolvedSlot();
+    const auto& boundingBox = system._boundingBoxes[slot];
+    return { boundingBox.position + system._positions[slot], boundingBox.size };
   }
 
-  void Transform::Update()
+  void Transform::SetLocalPosition(const Vector2D_i32& position) const
   {
-    _dirtyFlags.reset();
-    _dirtyFlags = _dirtyFlagsCurrentFrame;
-    _dirtyFlagsCurrentFrame.reset();
-  }
+    auto& system = GTransformSystem;
+    const auto slot = ResolvedSlot();
+    system._attachments[slot].localPosition = position;
 
-  void Transform::SetLocalPosition(const Vector2D_i32& position)
-  {
-    _attachmentData.localPosition = position;
-
-    assert(_parent);
-    if (_parent)
+    assert(system._parents[slot] != kInvalidTransformSlot);
+    if (system._parents[slot] != kInvalidTransformSlot)
     {
-      OnAttachedPositionChange();
+      OnAttachedPositionChange(slot);
     }
   }
 
-  void Transform::SetLocalPosition(const int32_t x, const int32_t y)
+  void Transform::SetLocalPosition(const int32_t x, const int32_t y) const
   {
     SetLocalPosition({ x, y });
   }
 
-  void Transform::OnAttachedPositionChange()
+  void Transform::OnAttachedPositionChange(const uint32_t slot)
   {
-    assert(_parent);
-    Vector2D_i32 destination = _parent->GetPosition();
+    const auto& system = GTransformSystem;
+    const auto parent = system._parents[slot];
+    assert(parent != kInvalidTransformSlot);
+
+    const auto& attachment = system._attachments[slot];
+    const auto& parentPosition = system._positions[parent];
+    const auto& parentCenter = system._centerPositions[parent];
+    const auto& parentSize = system._sizes[parent];
+
+    Vector2D_i32 destination = parentPosition;
 
-    switch (_attachmentData.parentAnchor)
+    switch (attachment.parentAnchor)
     {
     case kAnchor_Center:
     case kAnchor_CenterBottom:
     case kAnchor_CenterTop:
-      destination.x = _parent->GetCenterX();
+      destination.x = parentCenter.x;
       break;
     case kAnchor_RightBottom:
     case kAnchor_RightCenter:
     case kAnchor_RightTop:
-      destination.x = _parent->GetX() + _parent->GetWidth();
+      destination.x = parentPosition.x + parentSize.w;
       break;
     }
 
-    switch (_attachmentData.parentAnchor)
+    switch (attachment.parentAnchor)
     {
     case kAnchor_Center:
     case kAnchor_LeftCenter:
     case kAnchor_RightCenter:
-      destination.y = _parent->GetCenterY();
+      destination.y = parentCenter.y;
       break;
     case kAnchor_CenterBottom:
     case kAnchor_LeftBottom:
     case kAnchor_RightBottom:
-      destination.y = _parent->GetY() + _parent->GetHeight();
+      destination.y = parentPosition.y + parentSize.h;
       break;
     }
 
     // Special case where we want to use SetCenterPosition
-    if (_attachmentData.childAnchor == kAnchor_Center)
+    if (attachment.childAnchor == kAnchor_Center)
     {
-      SetCenterPosition(destination + _attachmentData.localPosition);
+      SetCenterPosition(slot, destination + attachment.localPosition);
     }
     else
     {
+      const auto& size = system._sizes[slot];
       Vector2D_i32 topLeftOffset = kZeroVector2D_i32;
 
-      switch (_attachmentData.childAnchor)
+      switch (attachment.childAnchor)
       {
       case kAnchor_Center:
       case kAnchor_CenterBottom:
       case kAnchor_CenterTop:
-        topLeftOffset.x = -GetWidth() / 2;
+        topLeftOffset.x = -size.w / 2;
         break;
       case kAnchor_RightBottom:
       case kAnchor_RightCenter:
       case kAnchor_RightTop:
-        topLeftOffset.x = -GetWidth();
+        topLeftOffset.x = -size.w;
         break;
       }
 
-      switch (_attachmentData.childAnchor)
+      switch (attachment.childAnchor)
       {
       case kAnchor_Center:
       case kAnchor_LeftCenter:
       case kAnchor_RightCenter:
-        topLeftOffset.y = -GetHeight() / 2;
+        topLeftOffset.y = -size.h / 2;
         break;
       case kAnchor_CenterBottom:
       case kAnchor_LeftBottom:
       case kAnchor_RightBottom:
-        topLeftOffset.y = -GetHeight();
+        topLeftOffset.y = -size.h;
         break;
       }
 
-      SetPosition(destination + topLeftOffset + _attachmentData.localPosition);
+      SetPosition(slot, destination + topLeftOffset + attachment.localPosition);
     }
   }
 
-  void Transform::Attach(const std::shared_ptr<Transform>& other, const Vector2D_i32& localPosition, const Anchor& anchor, const Anchor& otherAnchor)
+  void Transform::Attach(const Transform& other, const Vector2D_i32& localPosition, const Anchor& anchor, const Anchor& otherAnchor) const
   {
-    assert(other);
-    _children.push_back(other);
+    assert(other.IsValid());
+    auto& system = GTransformSystem;
+    const auto child = other.Slot();
 
-    other->OnAttached(shared_from_this(), { localPosition, anchor, otherAnchor });
+    system.Link(ResolvedSlot(), child);
+    system._attachments[child] = { localPosition, anchor, otherAnchor };
+    OnAttachedPositionChange(child);
   }
 
-  void Transform::OnAttached(const std::shared_ptr<Transform>& parent, const TransformAttachmentData& data)
+  void Transform::Detach() const
   {
-    assert(parent);
-    _parent = parent;
-    _attachmentData = data;
-    OnAttachedPositionChange();
-  }
-
-  void Transform::OnChildDetached(const std::shared_ptr<Transform>& child)
-  {
-    _children.erase(std::remove(std::begin(_children), std::end(_children), child));
-  }
+    auto& system = GTransformSystem;
+    const auto slot = ResolvedSlot();
 
-  void Transform::Detach()
-  {
-    assert(_parent);
-    _parent->OnChildDetached(shared_from_this());
-    _parent = nullptr;
+    assert(system._parents[slot] != kInvalidTransformSlot);
+    system.Unlink(slot);
   }
 
   bool Transform::IsDirty(const DirtyFlag flag) const
   {
     assert(flag != kDirtyFlag_Count);
-    return _dirtyFlags[flag];
+    return GTransformSystem.IsDirty(Slot(), flag);
   }
 
   bool Transform::IsAttached() const
   {
-    return _parent != nullptr;
+    return GTransformSystem._parents[Slot()] != kInvalidTransformSlot;
+  }
+
+  Transform Transform::GetParent() const
+  {
+    const auto& system = GTransformSystem;
+    const auto parent = system._parents[Slot()];
+    return parent != kInvalidTransformSlot ? Transform(parent, system._generations[parent]) : Transform();
   }
-}
\ No newline at end of file
+}
@@ -105,12 +105,12 @@ namespace JadeEngine
   }
 
 
-  void TransformGroup::Add(const std::shared_ptr<Transform>& elementTransform)
+  void TransformGroup::Add(const Transform& elementTransform)
   {
     Add(elementTransform, _elements.size() == 0 ? 0 : _defaultSpacing);
   }
 
-  void TransformGroup::Add(const std::shared_ptr<Transform>& elementTransform, const int32_t spacing)
+  void TransformGroup::Add(const Transform& elementTransform, const int32_t spacing)
   {
     _elements.push_back(elementTransform);
     _spacing.push_back(spacing);
@@ -157,7 +157,7 @@ namespace JadeEngine
       {
       case kGroupDirection_Vertical:
       {
-        const auto width = std::accumulate(std::cbegin(_elements), std::cend(_elements), 0, [](const int32_t currentWidth, const std::shared_ptr<Transform>& element)
+        const auto width = std::accumulate(std::cbegin(_elements), std::cend(_elements), 0, [](const int32_t currentWidth, const Transform& element)
         {
           return std::max(currentWidth, element->GetWidth());
         });
@@ -172,7 +172,7 @@ namespace JadeEngine
       {
         assert(_direction == kGroupDirection_Horizontal);
 
-        const auto height = std::accumulate(std::cbegin(_elements), std::cend(_elements), 0, [](const int32_t currentHeight, const std::shared_ptr<Transform>& element)
+        const auto height = std::accumulate(std::cbegin(_elements), std::cend(_elements), 0, [](const int32_t currentHeight, const Transform& element)
         {
           return std::max(currentHeight, element->GetHeight());
         });
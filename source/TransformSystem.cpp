@@ -0,0 +1,266 @@
+#include "TransformSystem.h"
+
+#include "Transform.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace
+{
+  const uint32_t kNeverChangedFrame = UINT32_MAX;
+  const std::array<uint32_t, JadeEngine::kDirtyFlag_Count> kNeverChangedFrames = { kNeverChangedFrame, kNeverChangedFrame, kNeverChangedFrame, kNeverChangedFrame };
+}
+
+namespace JadeEngine
+{
+  TransformSystem GTransformSystem;
+
+  TransformSystem::TransformSystem()
+    : _frame(1)
+    , _deferredPropagation(false)
+    , _pendingPropagationCount(0)
+  {
+  }
+
+  Transform TransformSystem::Create()
+  {
+    uint32_t slot;
+    if (!_freeSlots.empty())
+    {
+      slot = _freeSlots.back();
+      _freeSlots.pop_back();
+
+      _positions[slot] = kZeroVector2D_i32;
+      _centerPositions[slot] = kZeroVector2D_i32;
+      _sizes[slot] = kZeroVector2D_i32;
+      _boundingBoxes[slot] = { 0, 0, 0, 0 };
+      _boundingBoxesSet[slot] = false;
+      _changeFrames[slot] = kNeverChangedFrames;
+      _previousChangeFrames[slot] = kNeverChangedFrames;
+      _lastChangeFrames[slot] = kNeverChangedFrame;
+      _attachments[slot] = { kZeroVector2D_i32, kDefaultAnchor, kDefaultAnchor };
+    }
+    else
+    {
+      slot = static_cast<uint32_t>(_generations.size());
+
+      _positions.push_back(kZeroVector2D_i32);
+      _centerPositions.push_back(kZeroVector2D_i32);
+      _sizes.push_back(kZeroVector2D_i32);
+      _boundingBoxes.emplace_back(0, 0, 0, 0);
+      _boundingBoxesSet.push_back(false);
+      _changeFrames.push_back(kNeverChangedFrames);
+      _previousChangeFrames.push_back(kNeverChangedFrames);
+      _lastChangeFrames.push_back(kNeverChangedFrame);
+      _attachments.push_back({ kZeroVector2D_i32, kDefaultAnchor, kDefaultAnchor });
+      _propagationPending.push_back(false);
+      _parents.push_back(kInvalidTransformSlot);
+      _firstChildren.push_back(kInvalidTransformSlot);
+      _lastChildren.push_back(kInvalidTransformSlot);
+      _nextSiblings.push_back(kInvalidTransformSlot);
+      _previousSiblings.push_back(kInvalidTransformSlot);
+      _generations.push_back(0);
+    }
+
+    return Transform(slot, _generations[slot]);
+  }
+
+  void TransformSystem::Destroy(const Transform& transform)
+  {
+    assert(IsAlive(transform));
+    const auto slot = transform._slot;
+
+    // Descendants that are about to be detached keep the position they would have had
+    if (_pendingPropagationCount != 0)
+    {
+      ResolveAncestors(slot);
+      if (_propagationPending[slot])
+      {
+        ResolveChildren(slot);
+      }
+    }
+
+    if (_parents[slot] != kInvalidTransformSlot)
+    {
+      Unlink(slot);
+    }
+
+    auto child = _firstChildren[slot];
+    while (child != kInvalidTransformSlot)
+    {
+      const auto next = _nextSiblings[child];
+      _parents[child] = kInvalidTransformSlot;
+      _nextSiblings[child] = kInvalidTransformSlot;
+      _previousSiblings[child] = kInvalidTransformSlot;
+      child = next;
+    }
+    _firstChildren[slot] = kInvalidTransformSlot;
+    _lastChildren[slot] = kInvalidTransformSlot;
+
+    _generations[slot]++;
+    _freeSlots.push_back(slot);
+  }
+
+  bool TransformSystem::IsAlive(const Transform& transform) const
+  {
+    return transform._slot < _generations.size() && _generations[transform._slot] == transform._generation;
+  }
+
+  void TransformSystem::Update()
+  {
+    // Changes of the frame that just ended become the dirty ones, the older ones now have a frame number that no longer matches
+    _frame++;
+    std::swap(_dirtyTransforms, _changedTransforms);
+    _changedTransforms.clear();
+  }
+
+  void TransformSystem::MarkDirty(const uint32_t slot, const uint8_t flags)
+  {
+    if (_lastChangeFrames[slot] != _frame)
+    {
+      _lastChangeFrames[slot] = _frame;
+      _changedTransforms.push_back(Transform(slot, _generations[slot]));
+    }
+
+    auto& changeFrames = _changeFrames[slot];
+    for (size_t flag = 0; flag < kDirtyFlag_Count; flag++)
+    {
+      // The previous change is kept so that the flag stays dirty for the whole frame after the change
+      if ((flags & (1 << flag)) != 0 && changeFrames[flag] != _frame)
+      {
+        _previousChangeFrames[slot][flag] = changeFrames[flag];
+        changeFrames[flag] = _frame;
+      }
+    }
+  }
+
+  bool TransformSystem::IsDirty(const uint32_t slot, const DirtyFlag flag) const
+  {
+    const auto previousFrame = _frame - 1;
+    const auto changeFrame = _changeFrames[slot][flag];
+    return changeFrame == previousFrame || (changeFrame == _frame && _previousChangeFrames[slot][flag] == previousFrame);
+  }
+
+  void TransformSystem::Propagate()
+  {
+    // Resolving a subtree marks and resolves its descendants, which appends them, hence indexed
+    for (size_t i = 0; i < _pendingPropagations.size(); i++)
+    {
+      const auto slot = _pendingPropagations[i];
+      if (_propagationPending[slot])
+      {
+        // A pending ancestor moves this transform as well so it must go first
+        ResolveAncestors(slot);
+        if (_propagationPending[slot])
+        {
+          ResolveChildren(slot);
+        }
+      }
+    }
+
+    assert(_pendingPropagationCount == 0);
+    _pendingPropagations.clear();
+  }
+
+  void TransformSystem::SetDeferredPropagation(const bool deferred)
+  {
+    Propagate();
+    _deferredPropagation = deferred;
+  }
+
+  void TransformSystem::MarkPropagationPending(const uint32_t slot)
+  {
+    if (!_propagationPending[slot])
+    {
+      _propagationPending[slot] = true;
+      _pendingPropagationCount++;
+      _pendingPropagations.push_back(slot);
+    }
+  }
+
+  void TransformSystem::ResolveAncestors(const uint32_t slot)
+  {
+    auto topmost = kInvalidTransformSlot;
+    for (auto ancestor = _parents[slot]; ancestor != kInvalidTransformSlot; ancestor = _parents[ancestor])
+    {
+      if (_propagationPending[ancestor])
+      {
+        topmost = ancestor;
+      }
+    }
+
+    if (topmost != kInvalidTransformSlot)
+    {
+      ResolveChildren(topmost);
+    }
+  }
+
+  void TransformSystem::ResolveChildren(const uint32_t slot)
+  {
+    assert(_propagationPending[slot]);
+    _propagationPending[slot] = false;
+    _pendingPropagationCount--;
+
+    for (auto child = _firstChildren[slot]; child != kInvalidTransformSlot; child = _nextSiblings[child])
+    {
+      Transform::OnAttachedPositionChange(child);
+      if (_propagationPending[child])
+      {
+        ResolveChildren(child);
+      }
+    }
+  }
+
+  void TransformSystem::Link(const uint32_t parent, const uint32_t child)
+  {
+    if (_parents[child] != kInvalidTransformSlot)
+    {
+      Unlink(child);
+    }
+
+    _parents[child] = parent;
+    _previousSiblings[child] = _lastChildren[parent];
+    _nextSiblings[child] = kInvalidTransformSlot;
+
+    if (_lastChildren[parent] != kInvalidTransformSlot)
+    {
+      _nextSiblings[_lastChildren[parent]] = child;
+    }
+    else
+    {
+      _firstChildren[parent] = child;
+    }
+    _lastChildren[parent] = child;
+  }
+
+  void TransformSystem::Unlink(const uint32_t child)
+  {
+    const auto parent = _parents[child];
+    assert(parent != kInvalidTransformSlot);
+
+    const auto previous = _previousSiblings[child];
+    const auto next = _nextSiblings[child];
+
+    if (previous != kInvalidTransformSlot)
+    {
+      _nextSiblings[previous] = next;
+    }
+    else
+    {
+      _firstChildren[parent] = next;
+    }
+
+    if (next != kInvalidTransformSlot)
+    {
+      _previousSiblings[next] = previous;
+    }
+    else
+    {
+      _lastChildren[parent] = previous;
+    }
+
+    _parents[child] = kInvalidTransformSlot;
+    _previousSiblings[child] = kInvalidTransformSlot;
+    _nextSiblings[child] = kInvalidTransformSlot;
+  }
+}
@@ -0,0 +1,175 @@
+#include "UIEvents.h"
+
+#include "IGameObject.h"
+#include "Input.h"
+#include "Sprite.h"
+
+#include <algorithm>
+
+namespace
+{
+  const int32_t kRoutedMouseButtons[] = { SDL_BUTTON_LEFT, SDL_BUTTON_MIDDLE, SDL_BUTTON_RIGHT };
+
+  bool Contains(const std::vector<JadeEngine::Transform>& transforms, const JadeEngine::Transform& transform)
+  {
+    return std::find(std::cbegin(transforms), std::cend(transforms), transform) != std::cend(transforms);
+  }
+}
+
+namespace JadeEngine
+{
+  UIEventRouter::UIEventRouter(const std::vector<std::pair<Transform, IGameObject*>>& transformObjects)
+    : _transformObjects(transformObjects)
+    , _frame(0)
+  {
+  }
+
+  IGameObject* UIEventRouter::Resolve(const Transform& transform) const
+  {
+    const auto index = transform.GetIndex();
+    if (index >= _transformObjects.size() || _transformObjects[index].first != transform || !transform.IsValid())
+    {
+      return nullptr;
+    }
+
+    const auto gameObject = _transformObjects[index].second;
+    return gameObject->DestructionWanted() ? nullptr : gameObject;
+  }
+
+  void UIEventRouter::SetCaptor(IGameObject* gameObject)
+  {
+    _captor = gameObject != nullptr ? gameObject->transform : Transform();
+  }
+
+  void UIEventRouter::CollectPath(Sprite* hoveredSprite)
+  {
+    _path.clear();
+    _nextHoveredPath.clear();
+
+    if (hoveredSprite == nullptr)
+    {
+      return;
+    }
+
+    for (auto transform = hoveredSprite->transform; transform.IsValid(); transform = transform->GetParent())
+    {
+      const auto gameObject = Resolve(transform);
+      if (gameObject != nullptr && gameObject->HasCapability(kObjectCapability_UIEvents))
+      {
+        _path.push_back(gameObject);
+        _nextHoveredPath.push_back(transform);
+      }
+    }
+  }
+
+  void UIEventRouter::Dispatch(Sprite* hoveredSprite)
+  {
+    _frame++;
+    CollectPath(hoveredSprite);
+
+    UIEvent event = {};
+    event.hoveredSprite = hoveredSprite;
+    event.frame = _frame;
+    event.phase = kUIEventPhase_Target;
+
+    // Only the receivers the hover moved out of or into are told, innermost first for Leave and outermost first for Enter
+    event.type = kUIEventType_Leave;
+    for (const auto& transform : _hoveredPath)
+    {
+      const auto gameObject = Resolve(transform);
+      if (gameObject != nullptr && !Contains(_nextHoveredPath, transform))
+      {
+        event.target = gameObject;
+        event.handled = false;
+        gameObject->OnUIEvent(event);
+      }
+    }
+
+    event.type = kUIEventType_Enter;
+    for (auto it = _nextHoveredPath.rbegin(); it != _nextHoveredPath.rend(); ++it)
+    {
+      const auto gameObject = Resolve(*it);
+      if (gameObject != nullptr && !Contains(_hoveredPath, *it))
+      {
+        event.target = gameObject;
+        event.handled = false;
+        gameObject->OnUIEvent(event);
+      }
+    }
+
+    std::swap(_hoveredPath, _nextHoveredPath);
+
+    for (const auto button : kRoutedMouseButtons)
+    {
+      const auto down = GInput.MouseButtonDown(button);
+      const auto released = GInput.MouseButtonReleased(button);
+      event.mouseButton = button;
+
+      // Both edges can happen within one frame, a button that is down again was released first
+      if (released && down)
+      {
+        event.type = kUIEventType_Release;
+        Deliver(event);
+      }
+
+      if (GInput.MouseButtonPressed(button))
+      {
+        event.type = kUIEventType_Press;
+        Deliver(event);
+      }
+
+      if (released && !down)
+      {
+        event.type = kUIEventType_Release;
+        Deliver(event);
+      }
+    }
+    event.mouseButton = 0;
+
+    if (GInput.GetMouseWheelY() != 0)
+    {
+      event.type = kUIEventType_Wheel;
+      event.wheelY = GInput.GetMouseWheelY();
+      Deliver(event);
+      event.wheelY = 0;
+    }
+
+    event.type = kUIEventType_Key;
+    for (const auto key : GInput.GetPressedKeys())
+    {
+      event.key = key;
+      Deliver(event);
+    }
+  }
+
+  void UIEventRouter::Deliver(UIEvent& event)
+  {
+    event.handled = false;
+
+    // Looked up for every event as a receiver of the previous one may have captured or released the mouse
+    if (const auto captor = GetCaptor())
+    {
+      event.target = captor;
+      event.phase = kUIEventPhase_Target;
+      captor->OnUIEvent(event);
+      return;
+    }
+
+    event.target = event.hoveredSprite;
+
+    for (auto it = _path.rbegin(); it != _path.rend() && !event.handled; ++it)
+    {
+      event.phase = *it == event.target ? kUIEventPhase_Target : kUIEventPhase_Capture;
+      (*it)->OnUIEvent(event);
+    }
+
+    for (auto it = _path.begin(); it != _path.end() && !event.handled; ++it)
+    {
+      if (*it != event.target)
+      {
+        event.phase = kUIEventPhase_Bubble;
+        (*it)->OnUIEvent(event);
+      }
+    }
+  }
+}
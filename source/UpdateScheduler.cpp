@@ -0,0 +1,259 @@
+#include "UpdateScheduler.h"
+
+#include "EngineTime.h"
+#include "IGameObject.h"
+#include "ObjectAllocator.h"
+
+#include <algorithm>
+#include <cassert>
+#include <functional>
+
+namespace
+{
+  const size_t kNotScheduled = SIZE_MAX;
+  const uint32_t kNoSlot = UINT32_MAX;
+
+  void PushWake(std::vector<JadeEngine::detail::ScheduledWake>& wakes, const JadeEngine::detail::ScheduledWake& wake)
+  {
+    wakes.push_back(wake);
+    std::push_heap(std::begin(wakes), std::end(wakes), std::greater<JadeEngine::detail::ScheduledWake>());
+  }
+
+  JadeEngine::detail::ScheduledWake PopWake(std::vector<JadeEngine::detail::ScheduledWake>& wakes)
+  {
+    std::pop_heap(std::begin(wakes), std::end(wakes), std::greater<JadeEngine::detail::ScheduledWake>());
+    const auto result = wakes.back();
+    wakes.pop_back();
+    return result;
+  }
+}
+
+namespace JadeEngine
+{
+  UpdateScheduler::UpdateScheduler()
+    : _activeCount(0)
+    , _frame(0)
+    , _time(0.0)
+  {
+  }
+
+  void UpdateScheduler::Add(IGameObject* gameObject, void (*update)(std::vector<IGameObject*>&))
+  {
+    const auto typeId = gameObject->_objectType->id;
+    if (typeId >= _listIndices.size())
+    {
+      _listIndices.resize(typeId + 1, kNoSlot);
+    }
+
+    auto& list = _listIndices[typeId];
+    if (list == kNoSlot)
+    {
+      list = static_cast<uint32_t>(_lists.size());
+      _lists.push_back({ update, {}, 0 });
+    }
+
+    uint32_t slot;
+    if (!_freeSlots.empty())
+    {
+      slot = _freeSlots.back();
+      _freeSlots.pop_back();
+    }
+    else
+    {
+      slot = static_cast<uint32_t>(_slots.size());
+      _slots.push_back({});
+      _slots.back().generation = 0;
+    }
+
+    auto& entry = _slots[slot];
+    entry.gameObject = gameObject;
+    entry.list = list;
+    entry.listSlot = kNotScheduled;
+    entry.wokenSlot = kNotScheduled;
+    entry.nextFrame = 0;
+
+    gameObject->_updateScheduler = this;
+    gameObject->_scheduleSlot = slot;
+    OnPolicyChanged(gameObject);
+  }
+
+  void UpdateScheduler::Remove(IGameObject* gameObject)
+  {
+    assert(gameObject->_updateScheduler == this);
+    const auto slot = gameObject->_scheduleSlot;
+    auto& entry = _slots[slot];
+
+    Deactivate(slot);
+    if (entry.wokenSlot != kNotScheduled)
+    {
+      _woken[entry.wokenSlot] = kNoSlot;
+    }
+
+    // Pending timers of the slot are told apart from the ones of its next occupant by the generation
+    entry.gameObject = nullptr;
+    entry.generation++;
+    _freeSlots.push_back(slot);
+
+    gameObject->_updateScheduler = nullptr;
+    gameObject->_scheduleSlot = kNoSlot;
+  }
+
+  void UpdateScheduler::Update()
+  {
+    _frame++;
+    _time += GTime.deltaTime;
+
+    // Only compacted here as objects can leave their list while it is being updated
+    for (auto& list : _lists)
+    {
+      if (list.emptySlots * 2 > list.gameObjects.size())
+      {
+        auto& gameObjects = list.gameObjects;
+        gameObjects.erase(std::remove(std::begin(gameObjects), std::end(gameObjects), nullptr), std::end(gameObjects));
+        for (size_t i = 0; i < gameObjects.size(); i++)
+        {
+          _slots[gameObjects[i]->_scheduleSlot].listSlot = i;
+        }
+        list.emptySlots = 0;
+      }
+    }
+
+    WakeDue();
+
+    // Indexed as updating can create objects of a class which had no list yet
+    for (size_t i = 0; i < _lists.size(); i++)
+    {
+      auto& list = _lists[i];
+      list.update(list.gameObjects);
+    }
+
+    // Objects woken while these are updated, including by themselves, are updated next frame
+    std::swap(_woken, _waking);
+    for (const auto slot : _waking)
+    {
+      if (slot == kNoSlot)
+      {
+        continue;
+      }
+
+      _slots[slot].wokenSlot = kNotScheduled;
+      const auto gameObject = _slots[slot].gameObject;
+      if (gameObject->GetLoadState() == kLoadState_Done)
+      {
+        gameObject->Update();
+      }
+      else
+      {
+        WakeSlot(slot);
+      }
+    }
+    _waking.clear();
+  }
+
+  void UpdateScheduler::WakeDue()
+  {
+    while (!_frameWakes.empty() && _frameWakes.front().at <= static_cast<double>(_frame))
+    {
+      const auto wake = PopWake(_frameWakes);
+      const auto& entry = _slots[wake.slot];
+
+      // Interval changes schedule a new frame and leave the old one behind
+      if (entry.generation == wake.generation && entry.gameObject->_updatePolicy == kUpdatePolicy_EveryNthFrame
+        && static_cast<double>(entry.nextFrame) == wake.at)
+      {
+        WakeSlot(wake.slot);
+        ScheduleFrame(wake.slot);
+      }
+    }
+
+    while (!_timeWakes.empty() && _timeWakes.front().at <= _time)
+    {
+      const auto wake = PopWake(_timeWakes);
+      const auto& entry = _slots[wake.slot];
+      if (entry.generation == wake.generation)
+      {
+        Wake(entry.gameObject);
+      }
+    }
+  }
+
+  void UpdateScheduler::OnPolicyChanged(IGameObject* gameObject)
+  {
+    const auto slot = gameObject->_scheduleSlot;
+    switch (gameObject->_updatePolicy)
+    {
+    case kUpdatePolicy_EveryFrame:
+      Activate(slot);
+      break;
+    case kUpdatePolicy_EveryNthFrame:
+      Deactivate(slot);
+      ScheduleFrame(slot);
+      break;
+    case kUpdatePolicy_OnWake:
+      // Updated once more so the object can settle before it falls asleep
+      Deactivate(slot);
+      WakeSlot(slot);
+      break;
+    case kUpdatePolicy_Never:
+      Deactivate(slot);
+      break;
+    }
+  }
+
+  void UpdateScheduler::Wake(IGameObject* gameObject)
+  {
+    const auto policy = gameObject->_updatePolicy;
+    if (policy == kUpdatePolicy_EveryNthFrame || policy == kUpdatePolicy_OnWake)
+    {
+      WakeSlot(gameObject->_scheduleSlot);
+    }
+  }
+
+  void UpdateScheduler::WakeAfter(IGameObject* gameObject, const float seconds)
+  {
+    const auto slot = gameObject->_scheduleSlot;
+    PushWake(_timeWakes, { _time + seconds, slot, _slots[slot].generation });
+  }
+
+  void UpdateScheduler::Activate(const uint32_t slot)
+  {
+    auto& entry = _slots[slot];
+    if (entry.listSlot == kNotScheduled)
+    {
+      auto& list = _lists[entry.list];
+      entry.listSlot = list.gameObjects.size();
+      list.gameObjects.push_back(entry.gameObject);
+      _activeCount++;
+    }
+  }
+
+  void UpdateScheduler::Deactivate(const uint32_t slot)
+  {
+    auto& entry = _slots[slot];
+    if (entry.listSlot != kNotScheduled)
+    {
+      auto& list = _lists[entry.list];
+      list.gameObjects[entry.listSlot] = nullptr;
+      list.emptySlots++;
+      entry.listSlot = kNotScheduled;
+      _activeCount--;
+    }
+  }
+
+  void UpdateScheduler::WakeSlot(const uint32_t slot)
+  {
+    auto& entry = _slots[slot];
+    if (entry.wokenSlot == kNotScheduled)
+    {
+      entry.wokenSlot = _woken.size();
+      _woken.push_back(slot);
+    }
+  }
+
+  void UpdateScheduler::ScheduleFrame(const uint32_t slot)
+  {
+    auto& entry = _slots[slot];
+    entry.nextFrame = _frame + std::max(entry.gameObject->_updateInterval, 1u);
+    PushWake(_frameWakes, { static_cast<double>(entry.nextFrame), slot, entry.generation });
+  }
+}
@@ -0,0 +1,93 @@
+#include "WorkerPool.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace JadeEngine
+{
+  WorkerPool::WorkerPool(const size_t workerCount)
+    : _pushedCount(0)
+    , _returnedCount(0)
+    , _stopping(false)
+  {
+    assert(workerCount > 0);
+    for (size_t i = 0; i < workerCount; i++)
+    {
+      _workers.emplace_back(&WorkerPool::WorkerLoop, this);
+    }
+  }
+
+  WorkerPool::~WorkerPool()
+  {
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _stopping = true;
+    }
+    _jobPushed.notify_all();
+
+    for (auto& worker : _workers)
+    {
+      worker.join();
+    }
+  }
+
+  size_t WorkerPool::Push(std::function<void()> job)
+  {
+    size_t index;
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      index = _pushedCount++;
+      _jobs.emplace_back(index, std::move(job));
+    }
+    _jobPushed.notify_one();
+    return index;
+  }
+
+  bool WorkerPool::WaitFinished(size_t& index)
+  {
+    std::unique_lock<std::mutex> lock(_mutex);
+    if (_returnedCount == _pushedCount)
+    {
+      return false;
+    }
+
+    _jobFinished.wait(lock, [this]() { return !_finished.empty(); });
+    index = _finished.front();
+    _finished.pop_front();
+    _returnedCount++;
+    return true;
+  }
+
+  size_t WorkerPool::GetDefaultWorkerCount()
+  {
+    const auto hardwareThreads = static_cast<size_t>(std::thread::hardware_concurrency());
+    return std::max<size_t>(1, hardwareThreads > 1 ? hardwareThreads - 1 : 1);
+  }
+
+  void WorkerPool::WorkerLoop()
+  {
+    while (true)
+    {
+      std::pair<size_t, std::function<void()>> job;
+      {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _jobPushed.wait(lock, [this]() { return _stopping || !_jobs.empty(); });
+        if (_jobs.empty())
+        {
+          return;
+        }
+
+        job = std::move(_jobs.front());
+        _jobs.pop_front();
+      }
+
+      job.second();
+
+      {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _finished.push_back(job.first);
+      }
+      _jobFinished.notify_one();
+    }
+  }
+}